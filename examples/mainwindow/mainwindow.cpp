@@ -9,6 +9,7 @@
 #include <QtCore/QTime>
 #include <QtCore/QTimer>
 #include <QtGui/QPainter>
+#include <QtGui/QScreen>
 #include <QtGui/QWindow>
 #include <QtWidgets/QApplication>
 #include <QtWidgets/QStyle>
@@ -26,6 +27,7 @@
 
 #include <widgetframe/windowbar.h>
 #include <widgetframe/windowbutton.h>
+#include <widgetframe/decorationrasters.h>
 
 class ClockWidget : public QLabel {
 public:
@@ -59,7 +61,8 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent) {
     setCentralWidget(webView);
 #endif
 
-    loadStyleSheet(Dark);
+    loadStyleSheet();
+    setTheme(Dark);
 
     setWindowTitle(tr("Example MainWindow"));
     resize(800, 600);
@@ -68,70 +71,8 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent) {
     // windowAgent->centralize();
 }
 
-static inline void emulateLeaveEvent(QWidget *widget) {
-    Q_ASSERT(widget);
-    if (!widget) {
-        return;
-    }
-    QTimer::singleShot(0, widget, [widget]() {
-#if (QT_VERSION >= QT_VERSION_CHECK(5, 14, 0))
-        const QScreen *screen = widget->screen();
-#else
-        const QScreen *screen = widget->windowHandle()->screen();
-#endif
-        const QPoint globalPos = QCursor::pos(screen);
-        if (!QRect(widget->mapToGlobal(QPoint{0, 0}), widget->size()).contains(globalPos)) {
-            QCoreApplication::postEvent(widget, new QEvent(QEvent::Leave));
-            if (widget->testAttribute(Qt::WA_Hover)) {
-                const QPoint localPos = widget->mapFromGlobal(globalPos);
-                const QPoint scenePos = widget->window()->mapFromGlobal(globalPos);
-                static constexpr const auto oldPos = QPoint{};
-                const Qt::KeyboardModifiers modifiers = QGuiApplication::keyboardModifiers();
-#if (QT_VERSION >= QT_VERSION_CHECK(6, 4, 0))
-                const auto event =
-                    new QHoverEvent(QEvent::HoverLeave, scenePos, globalPos, oldPos, modifiers);
-                Q_UNUSED(localPos);
-#elif (QT_VERSION >= QT_VERSION_CHECK(6, 3, 0))
-                const auto event =  new QHoverEvent(QEvent::HoverLeave, localPos, globalPos, oldPos, modifiers);
-                Q_UNUSED(scenePos);
-#else
-                const auto event =  new QHoverEvent(QEvent::HoverLeave, localPos, oldPos, modifiers);
-                Q_UNUSED(scenePos);
-#endif
-                QCoreApplication::postEvent(widget, event);
-            }
-        }
-    });
-}
-
 MainWindow::~MainWindow() = default;
 
-bool MainWindow::event(QEvent *event) {
-    switch (event->type()) {
-        case QEvent::WindowActivate: {
-            auto menu = menuWidget();
-            if (menu) {
-                menu->setProperty("bar-active", true);
-                style()->polish(menu);
-            }
-            break;
-        }
-
-        case QEvent::WindowDeactivate: {
-            auto menu = menuWidget();
-            if (menu) {
-                menu->setProperty("bar-active", false);
-                style()->polish(menu);
-            }
-            break;
-        }
-
-        default:
-            break;
-    }
-    return QMainWindow::event(event);
-}
-
 void MainWindow::installWindowAgent() {
     // 1. Setup window agent
     windowAgent = new QWK::WidgetWindowAgent(this);
@@ -155,7 +96,7 @@ void MainWindow::installWindowAgent() {
         auto darkAction = new QAction(tr("Enable dark theme"), menuBar);
         darkAction->setCheckable(true);
         connect(darkAction, &QAction::triggered, this, [this](bool checked) {
-            loadStyleSheet(checked ? Dark : Light); //
+            setTheme(checked ? Dark : Light); //
         });
         connect(this, &MainWindow::themeChanged, darkAction, [this, darkAction]() {
             darkAction->setChecked(currentTheme == Dark); //
@@ -300,6 +241,20 @@ void MainWindow::installWindowAgent() {
     titleLabel->setObjectName(QStringLiteral("win-title-label"));
 
 #ifndef Q_OS_MAC
+    // Keep in sync with the icon sizes in the style sheets.
+    static const QSize pinIconSize(15, 15);
+    static const QSize systemIconSize(12, 12);
+
+    // Render the system button icons on a worker thread while the window is being set up,
+    // instead of on the first paint.
+    auto rasters = QWK::DecorationRasters::instance();
+    rasters->prewarm(QStringLiteral(":/window-bar/pin.svg"), pinIconSize);
+    rasters->prewarm(QStringLiteral(":/window-bar/pin-fill.svg"), pinIconSize);
+    rasters->prewarm(QStringLiteral(":/window-bar/minimize.svg"), systemIconSize);
+    rasters->prewarm(QStringLiteral(":/window-bar/maximize.svg"), systemIconSize);
+    rasters->prewarm(QStringLiteral(":/window-bar/restore.svg"), systemIconSize);
+    rasters->prewarm(QStringLiteral(":/window-bar/close.svg"), systemIconSize);
+
     auto iconButton = new QWK::WindowButton();
     iconButton->setObjectName(QStringLiteral("icon-button"));
     iconButton->setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Preferred);
@@ -325,6 +280,23 @@ void MainWindow::installWindowAgent() {
     closeButton->setObjectName(QStringLiteral("close-button"));
     closeButton->setProperty("system-button", true);
     closeButton->setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Preferred);
+
+    const auto loadSystemButtonIcons = [=]() {
+        pinButton->setIconNormal(
+            rasters->icon(QStringLiteral(":/window-bar/pin.svg"), pinIconSize));
+        pinButton->setIconChecked(
+            rasters->icon(QStringLiteral(":/window-bar/pin-fill.svg"), pinIconSize));
+        minButton->setIconNormal(
+            rasters->icon(QStringLiteral(":/window-bar/minimize.svg"), systemIconSize));
+        maxButton->setIconNormal(
+            rasters->icon(QStringLiteral(":/window-bar/maximize.svg"), systemIconSize));
+        maxButton->setIconChecked(
+            rasters->icon(QStringLiteral(":/window-bar/restore.svg"), systemIconSize));
+        closeButton->setIconNormal(
+            rasters->icon(QStringLiteral(":/window-bar/close.svg"), systemIconSize));
+    };
+    loadSystemButtonIcons();
+    connect(rasters, &QWK::DecorationRasters::prewarmed, this, loadSystemButtonIcons);
 #endif
 
     auto windowBar = new QWK::WindowBar();
@@ -338,8 +310,20 @@ void MainWindow::installWindowAgent() {
     windowBar->setMenuBar(menuBar);
     windowBar->setTitleLabel(titleLabel);
     windowBar->setHostWidget(this);
+    windowBar->setAutoFillBackground(true);
 
     windowAgent->setTitleBar(windowBar);
+
+    // The title bar colors of both themes, the agent applies the one of the current theme.
+    QPalette lightPalette = windowBar->palette();
+    lightPalette.setColor(QPalette::Window, QColor(0x19, 0x5A, 0xBE));
+    lightPalette.setColor(QPalette::WindowText, QColor(0xEC, 0xEC, 0xEC));
+    lightPalette.setColor(QPalette::ButtonText, QColor(0xEC, 0xEC, 0xEC));
+    QPalette darkPalette = windowBar->palette();
+    darkPalette.setColor(QPalette::Window, Qt::transparent);
+    darkPalette.setColor(QPalette::WindowText, QColor(0xEC, 0xEC, 0xEC));
+    darkPalette.setColor(QPalette::ButtonText, QColor(0xCC, 0xCC, 0xCC));
+    windowAgent->setTitleBarPalettes(lightPalette, darkPalette);
 #ifndef Q_OS_MAC
     windowAgent->setHitTestVisible(pinButton, true);
     windowAgent->setSystemButton(QWK::WindowAgentBase::WindowIcon, iconButton);
@@ -375,25 +359,60 @@ void MainWindow::installWindowAgent() {
         } else {
             showNormal();
         }
-
-        // It's a Qt issue that if a QAbstractButton::clicked triggers a window's maximization,
-        // the button remains to be hovered until the mouse move. As a result, we need to
-        // manually send leave events to the button.
-        emulateLeaveEvent(maxButton);
     });
+
+    // The hover state of a widget isn't updated when a click on it maximizes the window, the
+    // maximize button would stay hovered until the mouse moves. It is styled from the system
+    // button state of the agent instead, which follows the pointer over the whole window.
+    const auto updateMaxButtonState = [this, maxButton]() {
+        maxButton->setProperty("system-hovered", windowAgent->hoveredSystemButton() ==
+                                                     QWK::WindowAgentBase::Maximize);
+        maxButton->setProperty("system-pressed", windowAgent->pressedSystemButton() ==
+                                                     QWK::WindowAgentBase::Maximize);
+        // Property selectors are only reevaluated when the widget is polished again
+        style()->unpolish(maxButton);
+        style()->polish(maxButton);
+        maxButton->update();
+    };
+    connect(windowAgent, &QWK::WindowAgentBase::hoveredSystemButtonChanged, maxButton,
+            updateMaxButtonState);
+    connect(windowAgent, &QWK::WindowAgentBase::pressedSystemButtonChanged, maxButton,
+            updateMaxButtonState);
     connect(windowBar, &QWK::WindowBar::closeRequested, this, &QWidget::close);
 #endif
 }
 
-void MainWindow::loadStyleSheet(Theme theme) {
-    if (!styleSheet().isEmpty() && theme == currentTheme)
-        return;
-    currentTheme = theme;
-
-    if (QFile qss(theme == Dark ? QStringLiteral(":/dark-style.qss")
-                                : QStringLiteral(":/light-style.qss"));
+void MainWindow::loadStyleSheet() {
+    if (QFile qss(QStringLiteral(":/style.qss"));
         qss.open(QIODevice::ReadOnly | QIODevice::Text)) {
         setStyleSheet(QString::fromUtf8(qss.readAll()));
-        Q_EMIT themeChanged();
     }
 }
+
+void MainWindow::setTheme(Theme theme) {
+    currentTheme = theme;
+
+    // The style sheet is shared by both themes, switching only changes palettes: the title bar
+    // ones through the agent, the window and its menus here.
+    QPalette palette = this->palette();
+    const QColor text = theme == Dark ? QColor(0xCC, 0xCC, 0xCC) : QColor(0x33, 0x33, 0x33);
+    palette.setColor(QPalette::Window, theme == Dark ? QColor(0x1E, 0x1E, 0x1E)
+                                                     : QColor(0xF3, 0xF3, 0xF3));
+    palette.setColor(QPalette::WindowText, text);
+    palette.setColor(QPalette::Text, text);
+    palette.setColor(QPalette::ButtonText, text);
+    palette.setColor(QPalette::Disabled, QPalette::Text,
+                     theme == Dark ? QColor(0x66, 0x66, 0x66) : QColor(0xCC, 0xCC, 0xCC));
+    setPalette(palette);
+
+    QPalette menuPalette = palette;
+    menuPalette.setColor(QPalette::Window, theme == Dark ? QColor(0x30, 0x30, 0x30) : Qt::white);
+    if (auto bar = menuWidget()) {
+        for (auto menu : bar->findChildren<QMenu *>()) {
+            menu->setPalette(menuPalette);
+        }
+    }
+
+    windowAgent->setDarkTheme(theme == Dark);
+    Q_EMIT themeChanged();
+}
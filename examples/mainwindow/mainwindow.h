@@ -27,12 +27,10 @@ public:
 Q_SIGNALS:
     void themeChanged();
 
-protected:
-    bool event(QEvent *event) override;
-
 private:
     void installWindowAgent();
-    void loadStyleSheet(Theme theme);
+    void loadStyleSheet();
+    void setTheme(Theme theme);
 
     Theme currentTheme{};
 
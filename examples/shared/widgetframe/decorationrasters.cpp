@@ -0,0 +1,191 @@
+// Copyright (C) 2023-2024 Stdware Collections (https://www.github.com/stdware)
+// SPDX-License-Identifier: Apache-2.0
+
+#include "decorationrasters.h"
+#include "decorationrasters_p.h"
+
+#include <QtCore/QDebug>
+#include <QtCore/QPointer>
+#include <QtCore/QRunnable>
+#include <QtGui/QGuiApplication>
+#include <QtGui/QImageReader>
+#include <QtGui/QPixmap>
+#include <QtGui/QScreen>
+
+namespace QWK {
+
+    class DecorationRasterTask : public QRunnable {
+    public:
+        DecorationRasterTask(DecorationRastersPrivate *d, const QString &fileName,
+                             const QSize &size, qreal devicePixelRatio)
+            : d(d), fileName(fileName), size(size), devicePixelRatio(devicePixelRatio) {
+        }
+
+        void run() override {
+            d->finish(DecorationRastersPrivate::key(fileName, size, devicePixelRatio),
+                      DecorationRastersPrivate::render(fileName, size, devicePixelRatio));
+        }
+
+    private:
+        DecorationRastersPrivate *d;
+        QString fileName;
+        QSize size;
+        qreal devicePixelRatio;
+    };
+
+    DecorationRastersPrivate::DecorationRastersPrivate() = default;
+
+    DecorationRastersPrivate::~DecorationRastersPrivate() = default;
+
+    void DecorationRastersPrivate::init() {
+        Q_Q(DecorationRasters);
+        for (auto screen : QGuiApplication::screens()) {
+            watchScreen(screen);
+        }
+        QObject::connect(qApp, &QGuiApplication::screenAdded, q, [this](QScreen *screen) {
+            watchScreen(screen);
+            for (const auto &asset : std::as_const(assets)) {
+                queue(asset.first, asset.second, screen->devicePixelRatio());
+            }
+        });
+    }
+
+    QString DecorationRastersPrivate::key(const QString &fileName, const QSize &size,
+                                          qreal devicePixelRatio) {
+        return QStringLiteral("%1:%2x%3@%4")
+            .arg(fileName, QString::number(size.width()), QString::number(size.height()),
+                 QString::number(devicePixelRatio));
+    }
+
+    QImage DecorationRastersPrivate::render(const QString &fileName, const QSize &size,
+                                            qreal devicePixelRatio) {
+        // QImageReader is reentrant and the image format plugins (including the SVG one) render
+        // without touching any GUI thread state, unlike QIcon and QPixmap.
+        QImageReader reader(fileName);
+        reader.setScaledSize((QSizeF(size) * devicePixelRatio).toSize());
+        QImage image = reader.read();
+        if (image.isNull()) {
+            qWarning().noquote() << "DecorationRasters: failed to render" << fileName << ":"
+                                 << reader.errorString();
+            return {};
+        }
+        // This is the format QPixmap::fromImage() takes without another conversion.
+        image = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+        image.setDevicePixelRatio(devicePixelRatio);
+        return image;
+    }
+
+    QList<qreal> DecorationRastersPrivate::screenRatios() {
+        QList<qreal> ratios;
+        for (auto screen : QGuiApplication::screens()) {
+            qreal ratio = screen->devicePixelRatio();
+            if (!ratios.contains(ratio)) {
+                ratios.append(ratio);
+            }
+        }
+        return ratios;
+    }
+
+    void DecorationRastersPrivate::watchScreen(QScreen *screen) {
+        Q_Q(DecorationRasters);
+        // The device pixel ratio follows the logical DPI when the scale factor is not fixed.
+        QObject::connect(screen, &QScreen::logicalDotsPerInchChanged, q, [this, screen]() {
+            for (const auto &asset : std::as_const(assets)) {
+                queue(asset.first, asset.second, screen->devicePixelRatio());
+            }
+        });
+    }
+
+    void DecorationRastersPrivate::queue(const QString &fileName, const QSize &size,
+                                         qreal devicePixelRatio) {
+        const QString k = key(fileName, size, devicePixelRatio);
+        {
+            QMutexLocker locker(&mutex);
+            if (images.contains(k) || pending.contains(k)) {
+                return;
+            }
+            pending.insert(k);
+        }
+        pool.start(new DecorationRasterTask(this, fileName, size, devicePixelRatio));
+    }
+
+    void DecorationRastersPrivate::finish(const QString &key, const QImage &image) {
+        Q_Q(DecorationRasters);
+        bool done;
+        {
+            QMutexLocker locker(&mutex);
+            images.insert(key, image);
+            pending.remove(key);
+            done = pending.isEmpty();
+        }
+        if (done) {
+            QMetaObject::invokeMethod(q, &DecorationRasters::prewarmed, Qt::QueuedConnection);
+        }
+    }
+
+    DecorationRasters::~DecorationRasters() = default;
+
+    /*!
+        Returns the application wide instance, it must be used on the GUI thread.
+    */
+    DecorationRasters *DecorationRasters::instance() {
+        static QPointer<DecorationRasters> instance;
+        if (!instance) {
+            instance = new DecorationRasters(qApp);
+        }
+        return instance;
+    }
+
+    /*!
+        Renders the image file at \a size on a worker thread, for the device pixel ratio of every
+        connected screen. Screens connected later and scale changes are rendered as they come.
+        \c prewarmed() is emitted once all queued images are ready.
+    */
+    void DecorationRasters::prewarm(const QString &fileName, const QSize &size) {
+        Q_D(DecorationRasters);
+        const auto asset = qMakePair(fileName, size);
+        if (!d->assets.contains(asset)) {
+            d->assets.append(asset);
+        }
+        for (qreal ratio : DecorationRastersPrivate::screenRatios()) {
+            d->queue(fileName, size, ratio);
+        }
+    }
+
+    /*!
+        Returns the prewarmed image, or a null image if it is not ready. This function is thread
+        safe.
+    */
+    QImage DecorationRasters::image(const QString &fileName, const QSize &size,
+                                    qreal devicePixelRatio) const {
+        Q_D(const DecorationRasters);
+        QMutexLocker locker(&d->mutex);
+        return d->images.value(DecorationRastersPrivate::key(fileName, size, devicePixelRatio));
+    }
+
+    /*!
+        Returns an icon made of the prewarmed images of all connected screens. If any of them is
+        not ready yet, the file is loaded as a plain icon that renders on demand instead, so the
+        caller should fetch the icon again after \c prewarmed().
+    */
+    QIcon DecorationRasters::icon(const QString &fileName, const QSize &size) const {
+        QIcon icon;
+        for (qreal ratio : DecorationRastersPrivate::screenRatios()) {
+            QImage image = this->image(fileName, size, ratio);
+            if (image.isNull()) {
+                return QIcon(fileName);
+            }
+            icon.addPixmap(QPixmap::fromImage(image));
+        }
+        return icon;
+    }
+
+    DecorationRasters::DecorationRasters(QObject *parent)
+        : QObject(parent), d_ptr(new DecorationRastersPrivate()) {
+        Q_D(DecorationRasters);
+        d->q_ptr = this;
+
+        d->init();
+    }
+
+}
@@ -0,0 +1,40 @@
+// Copyright (C) 2023-2024 Stdware Collections (https://www.github.com/stdware)
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef DECORATIONRASTERS_H
+#define DECORATIONRASTERS_H
+
+#include <QtCore/QObject>
+#include <QtGui/QIcon>
+#include <QtGui/QImage>
+
+namespace QWK {
+
+    class DecorationRastersPrivate;
+
+    class DecorationRasters : public QObject {
+        Q_OBJECT
+        Q_DECLARE_PRIVATE(DecorationRasters)
+    public:
+        ~DecorationRasters();
+
+        static DecorationRasters *instance();
+
+    public:
+        void prewarm(const QString &fileName, const QSize &size);
+
+        QImage image(const QString &fileName, const QSize &size, qreal devicePixelRatio) const;
+        QIcon icon(const QString &fileName, const QSize &size) const;
+
+    Q_SIGNALS:
+        void prewarmed();
+
+    protected:
+        explicit DecorationRasters(QObject *parent = nullptr);
+
+        QScopedPointer<DecorationRastersPrivate> d_ptr;
+    };
+
+}
+
+#endif // DECORATIONRASTERS_H
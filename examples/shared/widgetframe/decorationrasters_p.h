@@ -0,0 +1,47 @@
+// Copyright (C) 2023-2024 Stdware Collections (https://www.github.com/stdware)
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef DECORATIONRASTERSPRIVATE_H
+#define DECORATIONRASTERSPRIVATE_H
+
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QSet>
+#include <QtCore/QThreadPool>
+
+#include "decorationrasters.h"
+
+namespace QWK {
+
+    class DecorationRastersPrivate {
+        Q_DECLARE_PUBLIC(DecorationRasters)
+    public:
+        DecorationRastersPrivate();
+        virtual ~DecorationRastersPrivate();
+
+        void init();
+
+        DecorationRasters *q_ptr;
+
+        QList<QPair<QString, QSize>> assets;
+
+        mutable QMutex mutex;
+        QHash<QString, QImage> images;
+        QSet<QString> pending;
+
+        // Declared last so that it is destroyed first, waiting for the running tasks while the
+        // storage is still alive.
+        QThreadPool pool;
+
+        static QString key(const QString &fileName, const QSize &size, qreal devicePixelRatio);
+        static QImage render(const QString &fileName, const QSize &size, qreal devicePixelRatio);
+        static QList<qreal> screenRatios();
+
+        void watchScreen(QScreen *screen);
+        void queue(const QString &fileName, const QSize &size, qreal devicePixelRatio);
+        void finish(const QString &key, const QImage &image);
+    };
+
+}
+
+#endif // DECORATIONRASTERSPRIVATE_H
@@ -4,15 +4,42 @@
 
 #include "abstractwindowcontext_p.h"
 
+#include <algorithm>
+#include <limits>
+
+#include <QtCore/QLineF>
+#include <QtCore/QScopeGuard>
+#include <QtGui/QGuiApplication>
 #include <QtGui/QPen>
+#include <QtGui/QMouseEvent>
 #include <QtGui/QPainter>
 #include <QtGui/QScreen>
 
 #include "qwkglobal_p.h"
+#include "systemwindow_p.h"
 
 namespace QWK {
 
-    AbstractWindowContext::AbstractWindowContext() = default;
+    // Makes the window let go of the press as if the button had been released far outside of
+    // it, so that its mouse grabber (a widget or a Quick item) doesn't keep the drag and nothing
+    // gets clicked.
+    static void releaseMouseGrab(QWindow *window) {
+        static constexpr const auto invalidPos =
+            QPoint{std::numeric_limits<int>::lowest(), std::numeric_limits<int>::lowest()};
+        QMouseEvent event(QEvent::MouseButtonRelease, invalidPos, invalidPos, invalidPos,
+                          Qt::LeftButton, QGuiApplication::mouseButtons() & ~Qt::LeftButton,
+                          QGuiApplication::keyboardModifiers());
+        QCoreApplication::sendEvent(window, &event);
+        window->setMouseGrabEnabled(false);
+    }
+
+    AbstractWindowContext::AbstractWindowContext()
+        : m_pointerPredictor(std::make_shared<PointerPredictor>()) {
+        m_attachedWindowsTimer.setSingleShot(true);
+        m_attachedWindowsTimer.setInterval(0);
+        connect(&m_attachedWindowsTimer, &QTimer::timeout, this,
+                &AbstractWindowContext::updateAttachedWindows);
+    }
 
     AbstractWindowContext::~AbstractWindowContext() = default;
 
@@ -58,6 +85,35 @@ namespace QWK {
             return false;
         }
         m_systemButtons[button] = obj;
+
+        // The replaced button can't stay hovered or pressed
+        if (m_hoveredSystemButton == button) {
+            setHoveredSystemButton(WindowAgentBase::Unknown);
+        }
+        if (m_pressedSystemButton == button) {
+            setPressedSystemButton(WindowAgentBase::Unknown);
+        }
+        return true;
+    }
+
+    bool AbstractWindowContext::setChildWindowForwarded(QWindow *window, bool forwarded) {
+        Q_ASSERT(window);
+        if (!window) {
+            return false;
+        }
+
+        m_forwardedChildWindows.removeAll(nullptr);
+        if (forwarded == m_forwardedChildWindows.contains(window)) {
+            return false;
+        }
+        if (!childWindowForwardingChanged(window, forwarded)) {
+            return false;
+        }
+        if (forwarded) {
+            m_forwardedChildWindows.append(window);
+        } else {
+            m_forwardedChildWindows.removeAll(window);
+        }
         return true;
     }
 
@@ -85,13 +141,18 @@ namespace QWK {
 
     bool AbstractWindowContext::isInSystemButtons(const QPoint &pos,
                                                   WindowAgentBase::SystemButton *button) const {
+        if (m_systemButtonHit.valid && m_systemButtonHit.pos == pos) {
+            *button = m_systemButtonHit.button;
+            return m_systemButtonHit.button != WindowAgentBase::Unknown;
+        }
+
         *button = WindowAgentBase::Unknown;
         for (int i = WindowAgentBase::WindowIcon; i <= WindowAgentBase::Close; ++i) {
             auto currentButton = m_systemButtons[i];
             if (!currentButton || !m_delegate->isVisible(currentButton) || !m_delegate->isEnabled(currentButton)) {
                 continue;
             }
-            if (m_delegate->mapGeometryToScene(currentButton).contains(pos)) {
+            if (m_delegate->hitTest(currentButton, pos)) {
                 *button = static_cast<WindowAgentBase::SystemButton>(i);
                 return true;
             }
@@ -110,14 +171,13 @@ namespace QWK {
             return false;
         }
         QRect windowRect = {QPoint(0, 0), m_windowHandle->size()};
-        QRect titleBarRect = m_delegate->mapGeometryToScene(m_titleBar);
-        if (!titleBarRect.intersects(windowRect)) {
-            // The title bar is totally outside the window for some reason,
-            // also treat it as there's no title bar.
+        if (!windowRect.contains(pos)) {
+            // Only the part of the title bar inside the window can be dragged, which also
+            // covers a title bar that is totally outside the window for some reason.
             return false;
         }
 
-        if (!titleBarRect.contains(pos)) {
+        if (!m_delegate->hitTest(m_titleBar, pos)) {
             return false;
         }
 
@@ -127,8 +187,7 @@ namespace QWK {
         }
 
         for (auto &&item : std::as_const(m_hitTestVisibleItems)) {
-            if (item && m_delegate->isVisible(item) &&
-                m_delegate->mapGeometryToScene(item).contains(pos)) {
+            if (item && m_delegate->isVisible(item) && m_delegate->hitTest(item, pos)) {
                 return false;
             }
         }
@@ -175,6 +234,23 @@ namespace QWK {
                 return;
             }
 
+            case StartSystemMoveHook: {
+                if (!m_windowId)
+                    return;
+
+                // The button may have been pressed on another window (e.g. a tab that is being
+                // torn off into this new window), release whatever Qt thinks is still grabbed
+                // there, the pointer is ours now.
+                auto source = static_cast<QWindow *>(data);
+                if (source && source != m_windowHandle) {
+                    releaseMouseGrab(source);
+                }
+                // Widgets keep the pressed widget globally, whichever window it belongs to
+                m_delegate->resetQtGrabbedControl(m_host);
+                startSystemMove(m_windowHandle, true, m_pointerPredictor);
+                return;
+            }
+
             case DefaultColorsHook: {
                 auto &map = *static_cast<QMap<QString, QColor> *>(data);
                 map.clear();
@@ -185,6 +261,17 @@ namespace QWK {
                 return;
             }
 
+            case MoveAttachedWindowsHook: {
+                // Each window is moved on its own, on X11 every move is a separate configure
+                // request. Wayland ignores the position of a toplevel window, the compositor
+                // places it, so attached windows don't follow there.
+                const auto &windows = *static_cast<const WindowPositionList *>(data);
+                for (const auto &item : windows) {
+                    item.first->setPosition(item.second);
+                }
+                return;
+            }
+
             default:
                 break;
         }
@@ -204,14 +291,41 @@ namespace QWK {
         // As a result, we must update our WindowContext each time the WinId changes.
         if (m_windowHandle) {
             removeEventFilter(m_windowHandle);
+            disconnect(m_windowScreenConnection);
+            disconnect(m_windowActiveConnection);
+            disconnect(m_windowStateConnection);
+            for (const auto &connection : std::as_const(m_windowSizeLimitConnections)) {
+                disconnect(connection);
+            }
         }
         m_windowHandle = m_delegate->hostWindow(m_host);
         if (m_windowHandle) {
             m_windowHandle->installEventFilter(this);
+            m_windowScreenConnection = connect(m_windowHandle, &QWindow::screenChanged, this,
+                                               &AbstractWindowContext::requestScreenUpdate);
+            m_windowActiveConnection = connect(m_windowHandle, &QWindow::activeChanged, this,
+                                               &AbstractWindowContext::updateWindowState);
+            m_windowStateConnection = connect(m_windowHandle, &QWindow::windowStateChanged, this,
+                                              &AbstractWindowContext::updateWindowState);
+            m_windowSizeLimitConnections = {
+                connect(m_windowHandle, &QWindow::minimumWidthChanged, this,
+                        &AbstractWindowContext::windowSizeLimitsChanged),
+                connect(m_windowHandle, &QWindow::minimumHeightChanged, this,
+                        &AbstractWindowContext::windowSizeLimitsChanged),
+                connect(m_windowHandle, &QWindow::maximumWidthChanged, this,
+                        &AbstractWindowContext::windowSizeLimitsChanged),
+                connect(m_windowHandle, &QWindow::maximumHeightChanged, this,
+                        &AbstractWindowContext::windowSizeLimitsChanged),
+            };
         }
+        updateScreen();
+        updateWindowCache();
+        updateWindowState();
 
         if (oldWinId != m_windowId) {
             winIdChanged(m_windowId, oldWinId);
+            // The backend may have changed the window flags
+            updateWindowCache();
 
             if (m_windowId) {
                 // Refresh window attributes
@@ -233,6 +347,19 @@ namespace QWK {
     }
 
     QVariant AbstractWindowContext::windowAttribute(const QString &key) const {
+        if (key == QStringLiteral("attachment-lag")) {
+            return m_attachmentLagCount > 0 ? m_attachmentLagTotal / m_attachmentLagCount : 0.0;
+        }
+        if (key == QStringLiteral("pointer-lag")) {
+            return m_pointerPredictor->measuredLag();
+        }
+        if (key == QStringLiteral("estimated-pointer-lag")) {
+            return m_pointerPredictor->estimatedLag();
+        }
+        if (key == QStringLiteral("estimated-predicted-pointer-lag")) {
+            return m_pointerPredictor->estimatedPredictedLag();
+        }
+
         auto it = m_windowAttributes.find(key);
         if (it == m_windowAttributes.end()) {
             return {};
@@ -273,8 +400,47 @@ namespace QWK {
     }
 
     bool AbstractWindowContext::eventFilter(QObject *obj, QEvent *event) {
-        if (obj == m_windowHandle && sharedDispatch(obj, event)) {
-            return true;
+#if QT_VERSION >= QT_VERSION_CHECK(6, 6, 0)
+        if (obj == m_windowHandle && event->type() == QEvent::DevicePixelRatioChange) {
+            requestScreenUpdate();
+        }
+#endif
+        if (obj == m_windowHandle) {
+            // QWindow doesn't notify flag changes, pick them up before they are needed
+            switch (event->type()) {
+                case QEvent::Show:
+                case QEvent::WindowStateChange:
+                case QEvent::PlatformSurface:
+                    updateWindowCache();
+                    break;
+                default:
+                    break;
+            }
+        }
+        if (obj == m_windowHandle && event->type() == QEvent::Move &&
+            !m_attachedWindows.isEmpty()) {
+            scheduleAttachedWindowsUpdate();
+        }
+        if (obj == m_windowHandle) {
+            updateSystemButtonState(event);
+            const auto systemButtonHitGuard = qScopeGuard([this]() {
+                m_systemButtonHit.valid = false; //
+            });
+            if (sharedDispatch(obj, event)) {
+                return true;
+            }
+        }
+        if (obj != m_windowHandle && isChildWindowForwarded(obj)) {
+            auto window = static_cast<QWindow *>(obj);
+            if (event->type() == QEvent::PlatformSurface) {
+                // The native window of the child has been recreated, forward the new one
+                if (static_cast<QPlatformSurfaceEvent *>(event)->surfaceEventType() ==
+                    QPlatformSurfaceEvent::SurfaceCreated) {
+                    childWindowForwardingChanged(window, true);
+                }
+            } else if (forwardChildWindowEvent(window, event)) {
+                return true;
+            }
         }
         return QObject::eventFilter(obj, event);
     }
@@ -282,9 +448,326 @@ namespace QWK {
     bool AbstractWindowContext::windowAttributeChanged(const QString &key,
                                                        const QVariant &attribute,
                                                        const QVariant &oldAttribute) {
+        Q_UNUSED(oldAttribute)
+
+        if (key == QStringLiteral("pointer-prediction")) {
+            m_pointerPredictor->setEnabled(attribute.toBool());
+            return true;
+        }
+        if (key == QStringLiteral("aspect-ratio")) {
+            // A size or a number, an invalid value frees the ratio
+            qreal ratio = 0;
+            if (attribute.canConvert<QSizeF>() && attribute.toSizeF().isValid()) {
+                const QSizeF size = attribute.toSizeF();
+                if (size.isEmpty()) {
+                    return false;
+                }
+                ratio = size.width() / size.height();
+            } else if (attribute.isValid()) {
+                bool ok = false;
+                ratio = attribute.toReal(&ok);
+                if (!ok || ratio <= 0) {
+                    return false;
+                }
+            }
+            m_aspectRatio = ratio;
+            return true;
+        }
         return false;
     }
 
+    bool AbstractWindowContext::childWindowForwardingChanged(QWindow *window, bool forwarded) {
+        // A native child window gets the pointer events of its area directly, they never go
+        // through the host window. Watch the child itself instead.
+        if (forwarded) {
+            window->installEventFilter(this);
+        } else {
+            window->removeEventFilter(this);
+        }
+        return true;
+    }
+
+    void AbstractWindowContext::windowSizeLimitsChanged() {
+        updateWindowCache();
+    }
+
+    void AbstractWindowContext::updateSystemButtonState(QEvent *event) {
+        switch (event->type()) {
+            case QEvent::MouseButtonPress:
+            case QEvent::MouseButtonDblClick:
+            case QEvent::MouseButtonRelease:
+            case QEvent::MouseMove: {
+                auto me = static_cast<const QMouseEvent *>(event);
+                const QPoint scenePos = getMouseEventScenePos(me);
+                WindowAgentBase::SystemButton button;
+                isInSystemButtons(scenePos, &button);
+                m_systemButtonHit.valid = true;
+                m_systemButtonHit.pos = scenePos;
+                m_systemButtonHit.button = button;
+                setHoveredSystemButton(button);
+
+                if (me->button() == Qt::LeftButton) {
+                    if (event->type() == QEvent::MouseButtonRelease) {
+                        setPressedSystemButton(WindowAgentBase::Unknown);
+                    } else if (event->type() != QEvent::MouseMove) {
+                        setPressedSystemButton(button);
+                    }
+                }
+                break;
+            }
+
+            case QEvent::Leave: {
+                // The pressed button is kept, it is released where the pointer is released
+                setHoveredSystemButton(WindowAgentBase::Unknown);
+                break;
+            }
+
+            case QEvent::Hide: {
+                setHoveredSystemButton(WindowAgentBase::Unknown);
+                setPressedSystemButton(WindowAgentBase::Unknown);
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+
+#define QWK_UPDATE_STATE(MEMBER, VALUE, NOTIFIER)                                                  \
+    do {                                                                                           \
+        if (MEMBER != (VALUE)) {                                                                   \
+            MEMBER = (VALUE);                                                                      \
+            Q_EMIT NOTIFIER(MEMBER);                                                               \
+        }                                                                                          \
+    } while (false)
+
+    void AbstractWindowContext::setHoveredSystemButton(WindowAgentBase::SystemButton button) {
+        QWK_UPDATE_STATE(m_hoveredSystemButton, button, hoveredSystemButtonChanged);
+    }
+
+    void AbstractWindowContext::setPressedSystemButton(WindowAgentBase::SystemButton button) {
+        QWK_UPDATE_STATE(m_pressedSystemButton, button, pressedSystemButtonChanged);
+    }
+
+    void AbstractWindowContext::setMoving(bool moving) {
+        if (moving && !m_moving) {
+            // The attachment lag is measured over the last move
+            m_attachmentLagTotal = 0;
+            m_attachmentLagCount = 0;
+        }
+        QWK_UPDATE_STATE(m_moving, moving, movingChanged);
+    }
+
+    void AbstractWindowContext::setResizing(bool resizing) {
+        QWK_UPDATE_STATE(m_resizing, resizing, resizingChanged);
+    }
+
+    void AbstractWindowContext::updateWindowState() {
+        m_windowCache.states = m_windowHandle ? m_windowHandle->windowStates() : Qt::WindowStates();
+        const bool active = m_windowHandle && m_windowHandle->isActive();
+        const bool maximized = m_windowCache.states & Qt::WindowMaximized;
+        QWK_UPDATE_STATE(m_active, active, activeChanged);
+        QWK_UPDATE_STATE(m_maximized, maximized, maximizedChanged);
+    }
+
+#undef QWK_UPDATE_STATE
+
+    void AbstractWindowContext::updateWindowCache() {
+        if (!m_windowHandle) {
+            m_windowCache = {};
+            return;
+        }
+        m_windowCache.flags = m_windowHandle->flags();
+        m_windowCache.states = m_windowHandle->windowStates();
+
+        const bool fixedDialog = m_windowCache.flags & Qt::MSWindowsFixedSizeDialogHint;
+        m_windowCache.fixedWidth =
+            fixedDialog || m_windowHandle->minimumWidth() == m_windowHandle->maximumWidth();
+        m_windowCache.fixedHeight =
+            fixedDialog || m_windowHandle->minimumHeight() == m_windowHandle->maximumHeight();
+    }
+
+    bool AbstractWindowContext::attachWindow(AbstractWindowContext *context,
+                                             const QPoint &offset) {
+        Q_ASSERT(context);
+        if (!context || context == this) {
+            return false;
+        }
+
+        // A window follows one parent only, and a parent can't follow its own children
+        for (auto parent = m_attachedTo.data(); parent; parent = parent->m_attachedTo) {
+            if (parent == context) {
+                return false;
+            }
+        }
+        if (context->m_attachedTo && context->m_attachedTo != this) {
+            context->m_attachedTo->detachWindow(context);
+        }
+
+        auto it = std::find_if(m_attachedWindows.begin(), m_attachedWindows.end(),
+                               [context](const AttachedWindow &item) {
+                                   return item.context == context;
+                               });
+        if (it != m_attachedWindows.end()) {
+            if (it->offset == offset) {
+                return true;
+            }
+            it->offset = offset;
+        } else {
+            m_attachedWindows.append({context, offset});
+            context->m_attachedTo = this;
+        }
+        scheduleAttachedWindowsUpdate();
+        return true;
+    }
+
+    bool AbstractWindowContext::detachWindow(AbstractWindowContext *context) {
+        if (!context) {
+            return false;
+        }
+        auto it = std::find_if(m_attachedWindows.begin(), m_attachedWindows.end(),
+                               [context](const AttachedWindow &item) {
+                                   return item.context == context;
+                               });
+        if (it == m_attachedWindows.end()) {
+            return false;
+        }
+        m_attachedWindows.erase(it);
+        context->m_attachedTo = nullptr;
+        return true;
+    }
+
+    void AbstractWindowContext::scheduleAttachedWindowsUpdate() {
+        // The moves reported within one pass of the event loop are folded into one batch, which
+        // is applied once the pending events have been processed.
+        if (m_attachedWindowsTimer.isActive()) {
+            return;
+        }
+        m_attachedWindowsTimer.start();
+    }
+
+    void AbstractWindowContext::updateAttachedWindows() {
+        if (!m_windowHandle) {
+            return;
+        }
+
+        WindowPositionList windows;
+        const QPoint origin = m_windowHandle->position();
+        for (auto it = m_attachedWindows.begin(); it != m_attachedWindows.end();) {
+            if (!it->context) {
+                it = m_attachedWindows.erase(it);
+                continue;
+            }
+            if (auto window = it->context->window()) {
+                QPoint pos = origin + it->offset;
+                // How far the window trails this one until it is moved into place
+                m_attachmentLagTotal += QLineF(window->position(), pos).length();
+                m_attachmentLagCount++;
+                if (window->position() != pos) {
+                    windows.append({window, pos});
+                }
+            }
+            ++it;
+        }
+        if (!windows.isEmpty()) {
+            virtual_hook(MoveAttachedWindowsHook, &windows);
+        }
+    }
+
+    bool AbstractWindowContext::forwardChildWindowEvent(QWindow *window, QEvent *event) {
+        auto type = event->type();
+        if (!m_windowHandle) {
+            return false;
+        }
+        if (type == QEvent::Leave) {
+            updateSystemButtonState(event);
+            return false;
+        }
+        if (type < QEvent::MouseButtonPress || type > QEvent::MouseMove) {
+            return false;
+        }
+
+        auto me = static_cast<const QMouseEvent *>(event);
+        QPoint globalPos = getMouseEventGlobalPos(me);
+        QPoint scenePos = m_windowHandle->mapFromGlobal(globalPos);
+        QMouseEvent mappedEvent(type, scenePos, globalPos, me->button(), me->buttons(),
+                                me->modifiers());
+        // The pointer predictor needs the original time of the event
+        mappedEvent.setTimestamp(me->timestamp());
+
+        // The host window doesn't see the pointer over the child, keep the hovered and the
+        // pressed system button up to date from here, whether the event is forwarded or not.
+        updateSystemButtonState(&mappedEvent);
+        const auto systemButtonHitGuard = qScopeGuard([this]() {
+            m_systemButtonHit.valid = false; //
+        });
+
+        switch (type) {
+            case QEvent::MouseButtonPress:
+            case QEvent::MouseButtonDblClick: {
+                // The child keeps the press unless it lands on draggable space, the rest of a
+                // forwarded press follows it.
+                if (!isInTitleBarDraggableArea(scenePos)) {
+                    m_forwardingChildWindow = nullptr;
+                    return false;
+                }
+                m_forwardingChildWindow = window;
+                break;
+            }
+            default: {
+                if (m_forwardingChildWindow != window) {
+                    return false;
+                }
+                if (type == QEvent::MouseButtonRelease && me->buttons() == Qt::NoButton) {
+                    m_forwardingChildWindow = nullptr;
+                }
+                break;
+            }
+        }
+        return sharedDispatch(m_windowHandle, &mappedEvent);
+    }
+
+    void AbstractWindowContext::requestScreenUpdate() {
+        // The platform may report a screen change, a DPI change and a DPR change for the same
+        // move in a row, and the new scale is not guaranteed to be applied to the window until
+        // all of them have been processed. Coalesce them and check once the event loop settles.
+        if (m_screenUpdatePending) {
+            return;
+        }
+        m_screenUpdatePending = true;
+        QMetaObject::invokeMethod(this, &AbstractWindowContext::updateScreen, Qt::QueuedConnection);
+    }
+
+    void AbstractWindowContext::updateScreen() {
+        m_screenUpdatePending = false;
+
+        QScreen *screen = m_windowHandle ? m_windowHandle->screen() : nullptr;
+        if (!screen) {
+            // Keep the last known values while the window is being recreated, so that coming
+            // back on another screen is still reported.
+            return;
+        }
+
+        if (screen != m_screen) {
+            disconnect(m_screenDpiConnection);
+            // The scale factor of the current screen can change without moving the window.
+            m_screenDpiConnection = connect(screen, &QScreen::logicalDotsPerInchChanged, this,
+                                            &AbstractWindowContext::requestScreenUpdate);
+        }
+
+        qreal dpr = m_windowHandle->devicePixelRatio();
+        if (screen == m_screen && qFuzzyCompare(dpr, m_devicePixelRatio)) {
+            return;
+        }
+
+        bool initial = qFuzzyIsNull(m_devicePixelRatio);
+        m_screen = screen;
+        m_devicePixelRatio = dpr;
+        if (!initial) {
+            Q_EMIT screenChanged(screen, dpr);
+        }
+    }
+
     void AbstractWindowContext::removeSystemButtonsAndHitTestItems() {
         for (auto &button : m_systemButtons) {
             if (!button) {
@@ -21,20 +21,26 @@
 
 #include <QtCore/QSet>
 #include <QtCore/QPointer>
+#include <QtCore/QTimer>
 #include <QtGui/QRegion>
+#include <QtGui/QScreen>
 #include <QtGui/QWindow>
 
 #include <QWKCore/windowagentbase.h>
 #include <QWKCore/private/nativeeventfilter_p.h>
 #include <QWKCore/private/sharedeventfilter_p.h>
+#include <QWKCore/private/windowhittester_p.h>
 #include <QWKCore/private/windowitemdelegate_p.h>
 #include <QWKCore/private/winidchangeeventfilter_p.h>
 
 namespace QWK {
 
+    class PointerPredictor;
+
     class QWK_CORE_EXPORT AbstractWindowContext : public QObject,
                                                   public NativeEventDispatcher,
-                                                  public SharedEventDispatcher {
+                                                  public SharedEventDispatcher,
+                                                  public WindowHitTester {
         Q_OBJECT
     public:
         AbstractWindowContext();
@@ -48,6 +54,9 @@ namespace QWK {
         inline WId windowId() const;
         inline WindowItemDelegate *delegate() const;
 
+        inline QScreen *screen() const;
+        inline qreal devicePixelRatio() const;
+
         inline bool isHitTestVisible(const QObject *obj) const;
         bool setHitTestVisible(QObject *obj, bool visible);
 
@@ -62,8 +71,42 @@ namespace QWK {
         void setSystemButtonAreaCallback(const ScreenRectCallback &callback);
 #endif
 
-        bool isInSystemButtons(const QPoint &pos, WindowAgentBase::SystemButton *button) const;
-        bool isInTitleBarDraggableArea(const QPoint &pos) const;
+        inline bool isChildWindowForwarded(const QObject *obj) const;
+        bool setChildWindowForwarded(QWindow *window, bool forwarded);
+
+        bool isInSystemButtons(const QPoint &pos,
+                               WindowAgentBase::SystemButton *button) const override;
+        bool isInTitleBarDraggableArea(const QPoint &pos) const override;
+
+        // The window state, updated from the context's own event handling
+        inline bool isActive() const;
+        inline bool isMaximized() const;
+        inline bool isMoving() const;
+        inline bool isResizing() const;
+        inline WindowAgentBase::SystemButton hoveredSystemButton() const;
+        inline WindowAgentBase::SystemButton pressedSystemButton() const;
+
+        void setMoving(bool moving);
+        void setResizing(bool resizing);
+
+        // Attached windows follow this window at a fixed offset from its position
+        bool attachWindow(AbstractWindowContext *context, const QPoint &offset);
+        bool detachWindow(AbstractWindowContext *context);
+        using WindowPositionList = QVector<QPair<QWindow *, QPoint>>;
+
+        inline const std::shared_ptr<PointerPredictor> &pointerPredictor() const;
+        inline qreal aspectRatio() const;
+
+        // The window properties that are read for every pointer event, cached and updated from
+        // their change notifications instead of being queried each time.
+        struct WindowCache {
+            Qt::WindowFlags flags;
+            Qt::WindowStates states;
+            bool fixedWidth = false;
+            bool fixedHeight = false;
+        };
+        inline const WindowCache &windowCache() const;
+        void updateWindowCache();
 
         inline bool isHostWidthFixed() const;
         inline bool isHostHeightFixed() const;
@@ -79,6 +122,8 @@ namespace QWK {
             DrawWindows10BorderHook_Emulated, // Only works on Windows 10, emulated workaround
             DrawWindows10BorderHook_Native,   // Only works on Windows 10, native workaround
             SystemButtonAreaChangedHook,      // Only works on Mac
+            StartSystemMoveHook,
+            MoveAttachedWindowsHook,
         };
         virtual void virtual_hook(int id, void *data);
 
@@ -88,6 +133,19 @@ namespace QWK {
         virtual QVariant windowAttribute(const QString &key) const;
         virtual bool setWindowAttribute(const QString &key, const QVariant &attribute);
 
+    Q_SIGNALS:
+        // Emitted once the window has settled on a new screen or a new device pixel ratio,
+        // anything cached per scale should be invalidated here.
+        void screenChanged(QScreen *screen, qreal devicePixelRatio);
+
+        // The state signals are emitted only when the value actually changes.
+        void activeChanged(bool active);
+        void maximizedChanged(bool maximized);
+        void movingChanged(bool moving);
+        void resizingChanged(bool resizing);
+        void hoveredSystemButtonChanged(WindowAgentBase::SystemButton button);
+        void pressedSystemButtonChanged(WindowAgentBase::SystemButton button);
+
     protected:
         bool eventFilter(QObject *obj, QEvent *event) override;
 
@@ -95,6 +153,9 @@ namespace QWK {
         virtual void winIdChanged(WId winId, WId oldWinId) = 0;
         virtual bool windowAttributeChanged(const QString &key, const QVariant &attribute,
                                             const QVariant &oldAttribute);
+        virtual bool childWindowForwardingChanged(QWindow *window, bool forwarded);
+        // Called when the minimum or maximum size of the window changes
+        virtual void windowSizeLimitsChanged();
 
     protected:
         QObject *m_host{};
@@ -103,6 +164,8 @@ namespace QWK {
         WId m_windowId{};
 
         QVector<QPointer<QObject>> m_hitTestVisibleItems;
+        QVector<QPointer<QWindow>> m_forwardedChildWindows;
+        QPointer<QWindow> m_forwardingChildWindow;
 #ifdef Q_OS_MAC
         ScreenRectCallback m_systemButtonAreaCallback;
 #endif
@@ -115,7 +178,60 @@ namespace QWK {
 
         std::unique_ptr<WinIdChangeEventFilter> m_winIdChangeEventFilter;
 
+        QPointer<QScreen> m_screen;
+        qreal m_devicePixelRatio{};
+        bool m_screenUpdatePending{};
+        QMetaObject::Connection m_windowScreenConnection;
+        QMetaObject::Connection m_screenDpiConnection;
+
+        std::shared_ptr<PointerPredictor> m_pointerPredictor;
+        qreal m_aspectRatio{};
+
+        // The agent keeps the public, bindable copy of the state, written through the signals
+        bool m_active{};
+        bool m_maximized{};
+        bool m_moving{};
+        bool m_resizing{};
+        WindowAgentBase::SystemButton m_hoveredSystemButton = WindowAgentBase::Unknown;
+        WindowAgentBase::SystemButton m_pressedSystemButton = WindowAgentBase::Unknown;
+
+        // The system button under the mouse event being dispatched, isInSystemButtons() answers
+        // from it so that the event filters don't classify the same position again.
+        struct {
+            bool valid = false;
+            QPoint pos;
+            WindowAgentBase::SystemButton button = WindowAgentBase::Unknown;
+        } m_systemButtonHit;
+        QMetaObject::Connection m_windowActiveConnection;
+        QMetaObject::Connection m_windowStateConnection;
+        std::array<QMetaObject::Connection, 4> m_windowSizeLimitConnections;
+
+        WindowCache m_windowCache;
+
+        struct AttachedWindow {
+            QPointer<AbstractWindowContext> context;
+            QPoint offset;
+        };
+        QVector<AttachedWindow> m_attachedWindows;
+        QPointer<AbstractWindowContext> m_attachedTo;
+        QTimer m_attachedWindowsTimer;
+        qreal m_attachmentLagTotal{};
+        int m_attachmentLagCount{};
+
         void removeSystemButtonsAndHitTestItems();
+
+        void updateSystemButtonState(QEvent *event);
+        void setHoveredSystemButton(WindowAgentBase::SystemButton button);
+        void setPressedSystemButton(WindowAgentBase::SystemButton button);
+        void updateWindowState();
+
+        void scheduleAttachedWindowsUpdate();
+        void updateAttachedWindows();
+
+        bool forwardChildWindowEvent(QWindow *window, QEvent *event);
+
+        void requestScreenUpdate();
+        void updateScreen();
     };
 
     inline QObject *AbstractWindowContext::host() const {
@@ -134,10 +250,60 @@ namespace QWK {
         return m_delegate.get();
     }
 
+    inline QScreen *AbstractWindowContext::screen() const {
+        return m_screen;
+    }
+
+    inline qreal AbstractWindowContext::devicePixelRatio() const {
+        return m_devicePixelRatio;
+    }
+
+    inline const std::shared_ptr<PointerPredictor> &
+        AbstractWindowContext::pointerPredictor() const {
+        return m_pointerPredictor;
+    }
+
+    inline qreal AbstractWindowContext::aspectRatio() const {
+        return m_aspectRatio;
+    }
+
+    inline bool AbstractWindowContext::isActive() const {
+        return m_active;
+    }
+
+    inline bool AbstractWindowContext::isMaximized() const {
+        return m_maximized;
+    }
+
+    inline bool AbstractWindowContext::isMoving() const {
+        return m_moving;
+    }
+
+    inline bool AbstractWindowContext::isResizing() const {
+        return m_resizing;
+    }
+
+    inline WindowAgentBase::SystemButton AbstractWindowContext::hoveredSystemButton() const {
+        return m_hoveredSystemButton;
+    }
+
+    inline WindowAgentBase::SystemButton AbstractWindowContext::pressedSystemButton() const {
+        return m_pressedSystemButton;
+    }
+
     inline bool AbstractWindowContext::isHitTestVisible(const QObject *obj) const {
         return m_hitTestVisibleItems.contains(const_cast<QObject *>(obj));
     }
 
+    inline bool AbstractWindowContext::isChildWindowForwarded(const QObject *obj) const {
+        for (const auto &window : m_forwardedChildWindows) {
+            if (obj && window.data() == obj) {
+                return true;
+            }
+        }
+        return false;
+    }
+
     inline QObject *
         AbstractWindowContext::systemButton(WindowAgentBase::SystemButton button) const {
         return m_systemButtons[button];
@@ -153,24 +319,20 @@ namespace QWK {
     }
 #endif
 
+    inline const AbstractWindowContext::WindowCache &AbstractWindowContext::windowCache() const {
+        return m_windowCache;
+    }
+
     inline bool AbstractWindowContext::isHostWidthFixed() const {
-        return m_windowHandle
-                   ? ((m_windowHandle->flags() & Qt::MSWindowsFixedSizeDialogHint) ||
-                      m_windowHandle->minimumWidth() == m_windowHandle->maximumWidth())
-                   : false;
+        return m_windowCache.fixedWidth;
     }
 
     inline bool AbstractWindowContext::isHostHeightFixed() const {
-        return m_windowHandle
-                   ? ((m_windowHandle->flags() & Qt::MSWindowsFixedSizeDialogHint) ||
-                      m_windowHandle->minimumHeight() == m_windowHandle->maximumHeight())
-                   : false;
+        return m_windowCache.fixedHeight;
     }
 
     inline bool AbstractWindowContext::isHostSizeFixed() const {
-        return m_windowHandle ? ((m_windowHandle->flags() & Qt::MSWindowsFixedSizeDialogHint) ||
-                                 m_windowHandle->minimumSize() == m_windowHandle->maximumSize())
-                              : false;
+        return m_windowCache.fixedWidth && m_windowCache.fixedHeight;
     }
 
 }
@@ -704,8 +704,8 @@ namespace QWK {
 
             case QEvent::MouseButtonDblClick: {
                 if (me->button() == Qt::LeftButton && inTitleBar && !m_context->isHostSizeFixed()) {
-                    Qt::WindowFlags windowFlags = delegate->getWindowFlags(host);
-                    Qt::WindowStates windowState = delegate->getWindowState(host);
+                    Qt::WindowFlags windowFlags = m_context->windowCache().flags;
+                    Qt::WindowStates windowState = m_context->windowCache().states;
                     if (!(windowState & Qt::WindowFullScreen)) {
                         if (windowState & Qt::WindowMaximized) {
                             delegate->setWindowState(host, windowState & ~Qt::WindowMaximized);
@@ -828,7 +828,7 @@ namespace QWK {
             }
             return ensureWindowProxy(m_windowId)->setBlurEffect(mode);
         }
-        return false;
+        return AbstractWindowContext::windowAttributeChanged(key, attribute, oldAttribute);
     }
 
 }
@@ -8,6 +8,7 @@
 #include "qwindowkit_linux.h"
 
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+#include <QtCore/QHash>
 #include <QtGui/qpa/qplatformnativeinterface.h>
 
 namespace QWK {
@@ -23,44 +24,623 @@ namespace QWK {
             seat, serial, x, y);
     }
 
+    // xdg-activation-v1 isn't exposed by Qt, we only need to send `activate` requests so that
+    // the interface is declared by hand instead of pulling in the generated protocol code.
+    static const struct wl_interface *xdg_activation_v1_types[] = {nullptr, nullptr};
+
+    static const struct wl_message xdg_activation_v1_requests[] = {
+        {"destroy",              "",   xdg_activation_v1_types},
+        {"get_activation_token", "n",  xdg_activation_v1_types},
+        {"activate",             "so", xdg_activation_v1_types},
+    };
+
+    static const struct wl_interface xdg_activation_v1_interface = {
+        "xdg_activation_v1", 1, 3, xdg_activation_v1_requests, 0, nullptr,
+    };
+
+    struct RegistryBindContext {
+        const struct wl_interface *interface;
+        struct wl_proxy *registry;
+        struct wl_proxy *result;
+    };
+
+    static void registry_handle_global(void *data, struct wl_proxy *registry, uint32_t name,
+                                       const char *interface, uint32_t version) {
+        Q_UNUSED(version)
+        constexpr auto WL_REGISTRY_BIND = 0;
+        auto ctx = static_cast<RegistryBindContext *>(data);
+        if (ctx->result || qstrcmp(interface, ctx->interface->name) != 0) {
+            return;
+        }
+        const auto &api = QWK::Private::waylandAPI();
+        ctx->result = api.wl_proxy_marshal_flags(
+            registry, WL_REGISTRY_BIND, ctx->interface, uint32_t(ctx->interface->version), 0,
+            name, ctx->interface->name, uint32_t(ctx->interface->version), nullptr);
+    }
+
+    static void registry_handle_global_remove(void *data, struct wl_proxy *registry,
+                                              uint32_t name) {
+        Q_UNUSED(data)
+        Q_UNUSED(registry)
+        Q_UNUSED(name)
+    }
+
+    static const struct {
+        void (*global)(void *, struct wl_proxy *, uint32_t, const char *, uint32_t);
+        void (*global_remove)(void *, struct wl_proxy *, uint32_t);
+    } registry_listener = {
+        registry_handle_global,
+        registry_handle_global_remove,
+    };
+
+    // Binds a global on a private event queue, so that Qt's own queue is never dispatched from
+    // here. Returns null if the compositor doesn't advertise the interface.
+    static struct wl_proxy *bindGlobal(struct wl_display *display,
+                                       const struct wl_interface *interface) {
+        constexpr auto WL_DISPLAY_GET_REGISTRY = 1;
+        const auto &api = QWK::Private::waylandAPI();
+        if (!api.canBindGlobals()) {
+            return nullptr;
+        }
+
+        auto queue = api.wl_display_create_queue(display);
+        if (!queue) {
+            return nullptr;
+        }
+        auto wrapper = static_cast<struct wl_proxy *>(api.wl_proxy_create_wrapper(display));
+        api.wl_proxy_set_queue(wrapper, queue);
+
+        RegistryBindContext ctx{interface, nullptr, nullptr};
+        ctx.registry = api.wl_proxy_marshal_flags(wrapper, WL_DISPLAY_GET_REGISTRY,
+                                                  api.wl_registry_interface,
+                                                  uint32_t(api.wl_proxy_get_version(wrapper)), 0,
+                                                  nullptr);
+        if (ctx.registry) {
+            api.wl_proxy_add_listener(
+                ctx.registry,
+                reinterpret_cast<void (**)(void)>(const_cast<decltype(registry_listener) *>(
+                    &registry_listener)),
+                &ctx);
+            api.wl_display_roundtrip_queue(display, queue);
+            api.wl_proxy_destroy(ctx.registry);
+        }
+        if (ctx.result) {
+            // Move it back to the default queue before the private one goes away
+            api.wl_proxy_set_queue(ctx.result, nullptr);
+        }
+        api.wl_proxy_wrapper_destroy(wrapper);
+        api.wl_event_queue_destroy(queue);
+        return ctx.result;
+    }
+
+    // Keeps the globals bound per display, a new connection (e.g. once Qt has reconnected to a
+    // restarted compositor) binds its own. The proxies of a display that has gone away can't be
+    // destroyed anymore, they are left behind.
+    static struct wl_proxy *cachedGlobal(struct wl_display *display,
+                                         const struct wl_interface *interface) {
+        static QHash<QPair<struct wl_display *, const struct wl_interface *>, struct wl_proxy *>
+            globals;
+        const auto key = qMakePair(display, interface);
+        auto it = globals.find(key);
+        if (it == globals.end()) {
+            it = globals.insert(key, bindGlobal(display, interface));
+        }
+        return it.value();
+    }
+
+    static struct wl_proxy *xdgActivation(struct wl_display *display) {
+        return cachedGlobal(display, &xdg_activation_v1_interface);
+    }
+
+    static inline void xdg_activation_v1_activate(struct wl_proxy *activation, const char *token,
+                                                  struct wl_surface *surface) {
+        constexpr auto XDG_ACTIVATION_V1_ACTIVATE = 2;
+        const auto &api = QWK::Private::waylandAPI();
+        api.wl_proxy_marshal_flags(activation, XDG_ACTIVATION_V1_ACTIVATE, nullptr,
+                                   api.wl_proxy_get_version(activation), 0, token, surface);
+    }
+
+    // org_kde_kwin_blur isn't exposed by Qt either, it is supported by KWin and some other
+    // compositors.
+    // https://invent.kde.org/libraries/plasma-wayland-protocols/-/blob/master/src/protocols/blur.xml
+    static const struct wl_interface *org_kde_kwin_blur_types[] = {nullptr};
+
+    static const struct wl_message org_kde_kwin_blur_requests[] = {
+        {"commit",     "",   org_kde_kwin_blur_types},
+        {"set_region", "?o", org_kde_kwin_blur_types},
+        {"release",    "",   org_kde_kwin_blur_types},
+    };
+
+    static const struct wl_interface org_kde_kwin_blur_interface = {
+        "org_kde_kwin_blur", 1, 3, org_kde_kwin_blur_requests, 0, nullptr,
+    };
+
+    static const struct wl_interface *org_kde_kwin_blur_manager_types[] = {
+        &org_kde_kwin_blur_interface,
+        nullptr,
+    };
+
+    static const struct wl_message org_kde_kwin_blur_manager_requests[] = {
+        {"create", "no", org_kde_kwin_blur_manager_types},
+        {"unset",  "o",  org_kde_kwin_blur_manager_types + 1},
+    };
+
+    static const struct wl_interface org_kde_kwin_blur_manager_interface = {
+        "org_kde_kwin_blur_manager", 1, 2, org_kde_kwin_blur_manager_requests, 0, nullptr,
+    };
+
+    static constexpr auto WL_MARSHAL_FLAG_DESTROY = 1;
+
+    static struct wl_proxy *kwinBlurManager(struct wl_display *display) {
+        return cachedGlobal(display, &org_kde_kwin_blur_manager_interface);
+    }
+
+#if QT_VERSION < QT_VERSION_CHECK(6, 7, 0)
+    // Qt binds wp_cursor_shape_v1 by itself since 6.7, before that every cursor change attaches
+    // a client buffer to the cursor surface. The shapes are set by enum here instead, and the
+    // compositor renders them.
+    // https://gitlab.freedesktop.org/wayland/wayland-protocols/-/blob/main/staging/cursor-shape/cursor-shape-v1.xml
+    static const struct wl_interface *wp_cursor_shape_device_v1_types[] = {nullptr, nullptr};
+
+    static const struct wl_message wp_cursor_shape_device_v1_requests[] = {
+        {"destroy",   "",   wp_cursor_shape_device_v1_types},
+        {"set_shape", "uu", wp_cursor_shape_device_v1_types},
+    };
+
+    static const struct wl_interface wp_cursor_shape_device_v1_interface = {
+        "wp_cursor_shape_device_v1", 1, 2, wp_cursor_shape_device_v1_requests, 0, nullptr,
+    };
+
+    static const struct wl_interface *wp_cursor_shape_manager_v1_types[] = {
+        &wp_cursor_shape_device_v1_interface,
+        nullptr,
+    };
+
+    static const struct wl_message wp_cursor_shape_manager_v1_requests[] = {
+        {"destroy",     "",   wp_cursor_shape_manager_v1_types},
+        {"get_pointer", "no", wp_cursor_shape_manager_v1_types},
+    };
+
+    static const struct wl_interface wp_cursor_shape_manager_v1_interface = {
+        "wp_cursor_shape_manager_v1", 1, 2, wp_cursor_shape_manager_v1_requests, 0, nullptr,
+    };
+
+    static uint32_t cursorShapeOf(Qt::CursorShape shape) {
+        switch (shape) {
+            case Qt::SizeHorCursor:
+                return 26; // ew_resize
+            case Qt::SizeVerCursor:
+                return 27; // ns_resize
+            case Qt::SizeBDiagCursor:
+                return 28; // nesw_resize
+            case Qt::SizeFDiagCursor:
+                return 29; // nwse_resize
+            default:
+                break;
+        }
+        return 1; // default
+    }
+
+    // The shape has to be set with the serial of the latest wl_pointer.enter, which Qt keeps to
+    // itself, the last input serial may be the one of a key or a button. A second wl_pointer of
+    // the seat receives the same enter events, it lives on the default queue so that Qt
+    // dispatches it along with its own, and the cursor shape device is created for it.
+    struct CursorShapePointer {
+        struct wl_display *display = nullptr;
+        struct wl_seat *seat = nullptr;
+        struct wl_proxy *pointer = nullptr;
+        struct wl_proxy *device = nullptr;
+        struct wl_proxy *surface = nullptr; // The surface the pointer has entered
+        uint32_t enterSerial = 0;
+    };
+
+    static void pointer_handle_enter(void *data, struct wl_proxy *pointer, uint32_t serial,
+                                     struct wl_proxy *surface, int32_t x, int32_t y) {
+        Q_UNUSED(pointer)
+        Q_UNUSED(x)
+        Q_UNUSED(y)
+        auto state = static_cast<CursorShapePointer *>(data);
+        state->surface = surface;
+        state->enterSerial = serial;
+    }
+
+    static void pointer_handle_leave(void *data, struct wl_proxy *pointer, uint32_t serial,
+                                     struct wl_proxy *surface) {
+        Q_UNUSED(pointer)
+        Q_UNUSED(serial)
+        auto state = static_cast<CursorShapePointer *>(data);
+        if (state->surface == surface) {
+            state->surface = nullptr;
+            state->enterSerial = 0;
+        }
+    }
+
+    static void pointer_handle_motion(void *, struct wl_proxy *, uint32_t, int32_t, int32_t) {
+    }
+
+    static void pointer_handle_button(void *, struct wl_proxy *, uint32_t, uint32_t, uint32_t,
+                                      uint32_t) {
+    }
+
+    static void pointer_handle_axis(void *, struct wl_proxy *, uint32_t, uint32_t, int32_t) {
+    }
+
+    static void pointer_handle_frame(void *, struct wl_proxy *) {
+    }
+
+    static void pointer_handle_axis_source(void *, struct wl_proxy *, uint32_t) {
+    }
+
+    static void pointer_handle_axis_stop(void *, struct wl_proxy *, uint32_t, uint32_t) {
+    }
+
+    static void pointer_handle_axis_discrete(void *, struct wl_proxy *, uint32_t, int32_t) {
+    }
+
+    static void pointer_handle_axis_value120(void *, struct wl_proxy *, uint32_t, int32_t) {
+    }
+
+    static void pointer_handle_axis_relative_direction(void *, struct wl_proxy *, uint32_t,
+                                                       uint32_t) {
+    }
+
+    // wl_pointer version 9
+    static const struct {
+        void (*enter)(void *, struct wl_proxy *, uint32_t, struct wl_proxy *, int32_t, int32_t);
+        void (*leave)(void *, struct wl_proxy *, uint32_t, struct wl_proxy *);
+        void (*motion)(void *, struct wl_proxy *, uint32_t, int32_t, int32_t);
+        void (*button)(void *, struct wl_proxy *, uint32_t, uint32_t, uint32_t, uint32_t);
+        void (*axis)(void *, struct wl_proxy *, uint32_t, uint32_t, int32_t);
+        void (*frame)(void *, struct wl_proxy *);
+        void (*axis_source)(void *, struct wl_proxy *, uint32_t);
+        void (*axis_stop)(void *, struct wl_proxy *, uint32_t, uint32_t);
+        void (*axis_discrete)(void *, struct wl_proxy *, uint32_t, int32_t);
+        void (*axis_value120)(void *, struct wl_proxy *, uint32_t, int32_t);
+        void (*axis_relative_direction)(void *, struct wl_proxy *, uint32_t, uint32_t);
+    } pointer_listener = {
+        pointer_handle_enter,         pointer_handle_leave,
+        pointer_handle_motion,        pointer_handle_button,
+        pointer_handle_axis,          pointer_handle_frame,
+        pointer_handle_axis_source,   pointer_handle_axis_stop,
+        pointer_handle_axis_discrete, pointer_handle_axis_value120,
+        pointer_handle_axis_relative_direction,
+    };
+    static constexpr auto kPointerListenerEventCount = 11;
+
+    // Returns the pointer of the seat Qt is using together with its cursor shape device, the
+    // device is null if the compositor lacks the protocol.
+    static CursorShapePointer *cursorShapePointer(QNativeInterface::QWaylandApplication *waylandApp) {
+        static CursorShapePointer state;
+
+        const auto &api = QWK::Private::waylandAPI();
+        auto display = waylandApp->display();
+        auto seat = waylandApp->seat();
+        if (!api.wl_proxy_add_listener || !api.wl_pointer_interface ||
+            api.wl_pointer_interface->event_count > kPointerListenerEventCount) {
+            return nullptr;
+        }
+
+        if (seat != state.seat || display != state.display) {
+            // The proxies of a display that has gone away can't be destroyed anymore
+            if (display == state.display) {
+                if (state.device) {
+                    constexpr auto WP_CURSOR_SHAPE_DEVICE_V1_DESTROY = 0;
+                    api.wl_proxy_marshal_flags(state.device, WP_CURSOR_SHAPE_DEVICE_V1_DESTROY,
+                                               nullptr, api.wl_proxy_get_version(state.device),
+                                               WL_MARSHAL_FLAG_DESTROY);
+                }
+                if (state.pointer) {
+                    constexpr auto WL_POINTER_RELEASE = 0;
+                    if (api.wl_proxy_get_version(state.pointer) >= 3) {
+                        api.wl_proxy_marshal_flags(state.pointer, WL_POINTER_RELEASE, nullptr,
+                                                   api.wl_proxy_get_version(state.pointer),
+                                                   WL_MARSHAL_FLAG_DESTROY);
+                    } else {
+                        api.wl_proxy_destroy(state.pointer);
+                    }
+                }
+            }
+            state = {};
+            state.display = display;
+            state.seat = seat;
+
+            auto manager = display ? cachedGlobal(display, &wp_cursor_shape_manager_v1_interface)
+                                   : nullptr;
+            if (seat && manager) {
+                constexpr auto WL_SEAT_GET_POINTER = 0;
+                auto seatProxy = reinterpret_cast<struct wl_proxy *>(seat);
+                state.pointer = api.wl_proxy_marshal_flags(
+                    seatProxy, WL_SEAT_GET_POINTER, api.wl_pointer_interface,
+                    api.wl_proxy_get_version(seatProxy), 0, nullptr);
+            }
+            if (state.pointer) {
+                api.wl_proxy_add_listener(
+                    state.pointer,
+                    reinterpret_cast<void (**)(void)>(
+                        const_cast<decltype(pointer_listener) *>(&pointer_listener)),
+                    &state);
+                constexpr auto WP_CURSOR_SHAPE_MANAGER_V1_GET_POINTER = 1;
+                state.device = api.wl_proxy_marshal_flags(
+                    manager, WP_CURSOR_SHAPE_MANAGER_V1_GET_POINTER,
+                    &wp_cursor_shape_device_v1_interface, api.wl_proxy_get_version(manager), 0,
+                    nullptr, state.pointer);
+                api.wl_display_flush(display);
+            }
+        }
+        return &state;
+    }
+
+    // Returns false if the shape can't be set through the compositor, e.g. before the enter
+    // event of the pointer has been received.
+    static bool setCompositorCursorShape(QWindow *window, Qt::CursorShape shape) {
+        auto *waylandApp = qApp->nativeInterface<QNativeInterface::QWaylandApplication>();
+        if (!window || !waylandApp || !waylandApp->display()) {
+            return false;
+        }
+        auto state = cursorShapePointer(waylandApp);
+        if (!state || !state->device || !state->enterSerial) {
+            return false;
+        }
+        auto surface = QGuiApplication::platformNativeInterface()->nativeResourceForWindow(
+            "surface", window);
+        if (!surface || surface != state->surface) {
+            return false;
+        }
+
+        constexpr auto WP_CURSOR_SHAPE_DEVICE_V1_SET_SHAPE = 1;
+        const auto &api = QWK::Private::waylandAPI();
+        api.wl_proxy_marshal_flags(state->device, WP_CURSOR_SHAPE_DEVICE_V1_SET_SHAPE, nullptr,
+                                   api.wl_proxy_get_version(state->device), 0,
+                                   state->enterSerial, cursorShapeOf(shape));
+        api.wl_display_flush(waylandApp->display());
+        return true;
+    }
+#endif
+
     LinuxWaylandContext::LinuxWaylandContext() = default;
 
-    LinuxWaylandContext::~LinuxWaylandContext() = default;
+    LinuxWaylandContext::~LinuxWaylandContext() {
+        releaseBlur();
+    }
 
     QString LinuxWaylandContext::key() const {
         return QStringLiteral("wayland");
     }
 
     void LinuxWaylandContext::virtual_hook(int id, void *data) {
-        if (id == ShowSystemMenuHook) {
-            auto *waylandApp = qApp->nativeInterface<QNativeInterface::QWaylandApplication>();
-            if (!waylandApp) {
+        switch (id) {
+            case RaiseWindowHook: {
+                if (!m_windowId)
+                    return;
+
+                m_delegate->setWindowVisible(m_host, true);
+                Qt::WindowStates state = m_delegate->getWindowState(m_host);
+                if (state & Qt::WindowMinimized) {
+                    m_delegate->setWindowState(m_host, state & ~Qt::WindowMinimized);
+                }
+
+                // Wayland clients can't raise themselves, the compositor only gives the focus
+                // away in exchange for an activation token. A token handed over from another
+                // process (e.g. XDG_ACTIVATION_TOKEN of a second instance) is the only way to
+                // get focus without waiting for the compositor to decide.
+                auto token = static_cast<const QString *>(data);
+                if (token && !token->isEmpty()) {
+                    auto *waylandApp =
+                        qApp->nativeInterface<QNativeInterface::QWaylandApplication>();
+                    wl_display *display = waylandApp ? waylandApp->display() : nullptr;
+                    auto activation = display ? xdgActivation(display) : nullptr;
+                    auto surface = static_cast<struct wl_surface *>(
+                        QGuiApplication::platformNativeInterface()->nativeResourceForWindow(
+                            "surface", m_windowHandle));
+                    if (activation && surface) {
+                        xdg_activation_v1_activate(activation, token->toUtf8().constData(),
+                                                   surface);
+                        const auto &api = QWK::Private::waylandAPI();
+                        api.wl_display_flush(display);
+                        return;
+                    }
+                }
+
+                // Lets Qt request a token for the last input serial if it supports it.
+                m_windowHandle->requestActivate();
                 return;
             }
-            uint serial = waylandApp->lastInputSerial();
-            wl_seat *seat = waylandApp->lastInputSeat();
-            if (serial == 0 || !seat) {
+
+            case ShowSystemMenuHook: {
+                auto *waylandApp = qApp->nativeInterface<QNativeInterface::QWaylandApplication>();
+                if (!waylandApp) {
+                    return;
+                }
+                uint serial = waylandApp->lastInputSerial();
+                wl_seat *seat = waylandApp->lastInputSeat();
+                if (serial == 0 || !seat) {
+                    return;
+                }
+
+                auto toplevel = static_cast<xdg_toplevel *>(
+                    QGuiApplication::platformNativeInterface()->nativeResourceForWindow(
+                        "xdg_toplevel", m_windowHandle));
+                if (!toplevel) {
+                    return;
+                }
+                auto pos = static_cast<const QPoint *>(data);
+                xdg_toplevel_show_window_menu(toplevel, seat, serial, pos->x(), pos->y());
+
+                wl_display *d = waylandApp->display();
+                if (d) {
+                    const auto &api = QWK::Private::waylandAPI();
+                    Q_ASSERT(api.isValid());
+                    api.wl_display_flush(d);
+                }
                 return;
             }
 
-            auto toplevel = static_cast<xdg_toplevel *>(
-                QGuiApplication::platformNativeInterface()->nativeResourceForWindow(
-                    "xdg_toplevel", m_windowHandle));
-            if (!toplevel) {
+            default:
+                break;
+        }
+        QtWindowContext::virtual_hook(id, data);
+    }
+
+#if QT_VERSION < QT_VERSION_CHECK(6, 7, 0)
+    void LinuxWaylandContext::setCursorShape(Qt::CursorShape shape) {
+        // A custom cursor of the host is shown through Qt's cursor surface, which the shape
+        // device would silently replace. The shape device is only used while Qt shows the
+        // default cursor, and one resize hover sticks to the path it has started with.
+        if (m_compositorCursorShape ||
+            (m_windowHandle && m_windowHandle->cursor().shape() == Qt::ArrowCursor)) {
+            if (setCompositorCursorShape(m_windowHandle, shape)) {
+                m_compositorCursorShape = true;
                 return;
             }
-            auto pos = static_cast<const QPoint *>(data);
-            xdg_toplevel_show_window_menu(toplevel, seat, serial, pos->x(), pos->y());
-
-            wl_display *d = waylandApp->display();
-            if (d) {
-                const auto &api = QWK::Private::waylandAPI();
-                Q_ASSERT(api.isValid());
-                api.wl_display_flush(d);
+            // The pointer has left, Qt sets its own cursor again when it comes back
+            m_compositorCursorShape = false;
+        }
+        QtWindowContext::setCursorShape(shape);
+    }
+
+    void LinuxWaylandContext::restoreCursorShape() {
+        if (m_compositorCursorShape) {
+            // Qt still believes its own default cursor is shown, give it back
+            m_compositorCursorShape = false;
+            std::ignore = setCompositorCursorShape(m_windowHandle, Qt::ArrowCursor);
+            return;
+        }
+        QtWindowContext::restoreCursorShape();
+    }
+#endif
+
+    bool LinuxWaylandContext::eventFilter(QObject *obj, QEvent *event) {
+        // The surface is created when the window gets exposed. Qt doesn't notify mask changes,
+        // compare the mask whenever the window is about to be drawn. An unchanged mask shares
+        // its data, so the comparison is cheap.
+        if (obj == m_windowHandle && m_blurEnabled &&
+            (event->type() == QEvent::Expose ||
+             ((event->type() == QEvent::Resize || event->type() == QEvent::UpdateRequest) &&
+              m_blur && m_windowHandle->mask() != m_blurRegion))) {
+            std::ignore = updateBlurRegion();
+        }
+        return QtWindowContext::eventFilter(obj, event);
+    }
+
+    bool LinuxWaylandContext::windowAttributeChanged(const QString &key,
+                                                     const QVariant &attribute,
+                                                     const QVariant &oldAttribute) {
+        Q_ASSERT(m_windowId);
+
+        if (key == QStringLiteral("blur-effect")) {
+            bool enabled;
+            if (!Private::blurEffectEnabled(attribute, &enabled)) {
+                return false;
+            }
+            auto *waylandApp = qApp->nativeInterface<QNativeInterface::QWaylandApplication>();
+            wl_display *display = waylandApp ? waylandApp->display() : nullptr;
+            if (enabled && (!display || !kwinBlurManager(display))) {
+                return false;
+            }
+            m_blurEnabled = enabled;
+            return updateBlurRegion();
+        }
+        return QtWindowContext::windowAttributeChanged(key, attribute, oldAttribute);
+    }
+
+    bool LinuxWaylandContext::updateBlurRegion() {
+        auto *waylandApp = qApp->nativeInterface<QNativeInterface::QWaylandApplication>();
+        wl_display *display = waylandApp ? waylandApp->display() : nullptr;
+        auto manager = display ? kwinBlurManager(display) : nullptr;
+        if (!manager) {
+            return false;
+        }
+
+        const auto &api = QWK::Private::waylandAPI();
+        auto ni = QGuiApplication::platformNativeInterface();
+        auto surface = m_windowHandle ? ni->nativeResourceForWindow("surface", m_windowHandle)
+                                      : nullptr;
+        if (surface != m_blurSurface) {
+            // The blur object died with the old surface
+            releaseBlur();
+        }
+        if (!surface) {
+            // Applied again once the window is exposed
+            return true;
+        }
+
+        if (!m_blurEnabled) {
+            if (m_blur) {
+                constexpr auto ORG_KDE_KWIN_BLUR_MANAGER_UNSET = 1;
+                api.wl_proxy_marshal_flags(manager, ORG_KDE_KWIN_BLUR_MANAGER_UNSET, nullptr,
+                                           api.wl_proxy_get_version(manager), 0, surface);
+                releaseBlur();
+                api.wl_display_flush(display);
+            }
+            return true;
+        }
+
+        // The region is in surface local coordinates, which are not scaled. Follow the shape of
+        // the window if it has one, otherwise a null region blurs the whole surface.
+        const QRegion region = m_windowHandle->mask();
+        if (m_blur && region == m_blurRegion) {
+            return true;
+        }
+
+        struct wl_proxy *wlRegion = nullptr;
+        if (!region.isEmpty()) {
+            auto compositor = static_cast<struct wl_proxy *>(
+                ni->nativeResourceForIntegration("compositor"));
+            if (!compositor || !api.wl_region_interface) {
+                return false;
+            }
+            constexpr auto WL_COMPOSITOR_CREATE_REGION = 1;
+            constexpr auto WL_REGION_ADD = 1;
+            wlRegion = api.wl_proxy_marshal_flags(compositor, WL_COMPOSITOR_CREATE_REGION,
+                                                  api.wl_region_interface,
+                                                  api.wl_proxy_get_version(compositor), 0,
+                                                  nullptr);
+            for (const QRect &rect : region) {
+                api.wl_proxy_marshal_flags(wlRegion, WL_REGION_ADD, nullptr,
+                                           api.wl_proxy_get_version(wlRegion), 0, rect.x(),
+                                           rect.y(), rect.width(), rect.height());
             }
-        } else {
-            QtWindowContext::virtual_hook(id, data);
         }
+
+        if (!m_blur) {
+            constexpr auto ORG_KDE_KWIN_BLUR_MANAGER_CREATE = 0;
+            m_blur = api.wl_proxy_marshal_flags(manager, ORG_KDE_KWIN_BLUR_MANAGER_CREATE,
+                                                &org_kde_kwin_blur_interface,
+                                                api.wl_proxy_get_version(manager), 0, nullptr,
+                                                surface);
+            m_blurSurface = surface;
+        }
+
+        constexpr auto ORG_KDE_KWIN_BLUR_COMMIT = 0;
+        constexpr auto ORG_KDE_KWIN_BLUR_SET_REGION = 1;
+        api.wl_proxy_marshal_flags(m_blur, ORG_KDE_KWIN_BLUR_SET_REGION, nullptr,
+                                   api.wl_proxy_get_version(m_blur), 0, wlRegion);
+        api.wl_proxy_marshal_flags(m_blur, ORG_KDE_KWIN_BLUR_COMMIT, nullptr,
+                                   api.wl_proxy_get_version(m_blur), 0);
+        if (wlRegion) {
+            constexpr auto WL_REGION_DESTROY = 0;
+            api.wl_proxy_marshal_flags(wlRegion, WL_REGION_DESTROY, nullptr,
+                                       api.wl_proxy_get_version(wlRegion),
+                                       WL_MARSHAL_FLAG_DESTROY);
+        }
+        api.wl_display_flush(display);
+        m_blurRegion = region;
+
+        // The blur state is double buffered, it takes effect with the next surface commit.
+        m_windowHandle->requestUpdate();
+        return true;
+    }
+
+    void LinuxWaylandContext::releaseBlur() {
+        if (m_blur) {
+            constexpr auto ORG_KDE_KWIN_BLUR_RELEASE = 2;
+            const auto &api = QWK::Private::waylandAPI();
+            api.wl_proxy_marshal_flags(m_blur, ORG_KDE_KWIN_BLUR_RELEASE, nullptr,
+                                       api.wl_proxy_get_version(m_blur), WL_MARSHAL_FLAG_DESTROY);
+        }
+        m_blur = nullptr;
+        m_blurSurface = nullptr;
+        m_blurRegion = {};
     }
 }
 #endif // QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
@@ -30,6 +30,30 @@ namespace QWK {
 
         QString key() const override;
         void virtual_hook(int id, void *data) override;
+
+#if QT_VERSION < QT_VERSION_CHECK(6, 7, 0)
+        void setCursorShape(Qt::CursorShape shape) override;
+        void restoreCursorShape() override;
+#endif
+
+    protected:
+        bool eventFilter(QObject *obj, QEvent *event) override;
+
+        bool windowAttributeChanged(const QString &key, const QVariant &attribute,
+                                    const QVariant &oldAttribute) override;
+
+    protected:
+#if QT_VERSION < QT_VERSION_CHECK(6, 7, 0)
+        bool m_compositorCursorShape = false;
+#endif
+
+        bool m_blurEnabled = false;
+        struct wl_proxy *m_blur = nullptr;
+        void *m_blurSurface = nullptr;
+        QRegion m_blurRegion;
+
+        bool updateBlurRegion();
+        void releaseBlur();
     };
 
 }
@@ -6,6 +6,10 @@
 
 #include "linuxx11context_p.h"
 
+#include <cstring>
+
+#include <QtGui/qpa/qplatformnativeinterface.h>
+
 #include "qwindowkit_linux.h"
 
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
@@ -125,7 +129,12 @@ union _XEvent {
 
 namespace QWK {
 
-    LinuxX11Context::LinuxX11Context() = default;
+    LinuxX11Context::LinuxX11Context() {
+        // The blur region is set in device pixels
+        connect(this, &AbstractWindowContext::screenChanged, this, [this]() {
+            std::ignore = updateBlurRegion(); //
+        });
+    }
 
     LinuxX11Context::~LinuxX11Context() = default;
 
@@ -133,61 +142,396 @@ namespace QWK {
         return QStringLiteral("xcb");
     }
 
+    // WM_NORMAL_HINTS holds the 18 fields of XSizeHints: flags, x, y, width, height, the
+    // minimum, maximum and increment sizes, the minimum and maximum aspects as numerator and
+    // denominator (fields 11 to 14), the base size and the gravity.
+    static constexpr auto kSizeHintsFieldCount = 18;
+
+    // Watches WM_NORMAL_HINTS of the window, which Qt rewrites when the window is mapped,
+    // resized or given new size limits, and has the aspect fields restored after each write.
+    class SizeHintsEventFilter : public AppNativeEventFilter {
+    public:
+        explicit SizeHintsEventFilter(LinuxX11Context *context) : m_context(context) {
+        }
+
+        bool nativeEventFilter(const NativeEvent &event, void *message,
+                               QT_NATIVE_EVENT_RESULT_TYPE *result) override {
+            Q_UNUSED(result)
+
+            // some marcos to constexpr in X11
+            constexpr auto PropertyNotify = 28;
+            constexpr auto XA_WM_NORMAL_HINTS = quint32(40);
+
+            if (event.type != NativeEvent::XcbEvent || event.messageType != PropertyNotify ||
+                event.windowId != m_context->m_windowId) {
+                return false;
+            }
+            // xcb_property_notify_event_t: the atom follows the window
+            quint32 atom;
+            std::memcpy(&atom, static_cast<const quint8 *>(message) + 8, sizeof(atom));
+            if (atom == XA_WM_NORMAL_HINTS) {
+                std::ignore = m_context->updateSizeHints();
+            }
+            return false;
+        }
+
+    private:
+        LinuxX11Context *m_context;
+    };
+
+    static bool sendRootClientMessage(Display *display, Window xwin, const char *atomName,
+                                      const long (&data)[5]) {
+        const auto &api = QWK::Private::x11API();
+        Q_ASSERT(api.isValid());
+
+        // some marcos to constexpr in X11
+        constexpr auto None = 0L;
+        constexpr auto ClientMessage = 33;
+        constexpr auto False = 0;
+        constexpr auto SubstructureNotifyMask = 1L << 19;
+        constexpr auto SubstructureRedirectMask = 1L << 20;
+
+        Atom atom = api.XInternAtom(display, atomName, False);
+        if (atom == None)
+            return false; // WM might not support this atom
+
+        XEvent ev{};
+        ev.xclient.type = ClientMessage;
+        ev.xclient.window = xwin;
+        ev.xclient.message_type = atom;
+
+        // The format member is set to 8, 16, or 32
+        // and specifies whether the data should be viewed as
+        // a list of bytes, shorts, or longs - typeof(xclient.data).
+        ev.xclient.format = 32;
+        for (int i = 0; i < 5; ++i) {
+            ev.xclient.data.l[i] = data[i];
+        }
+
+        Window root = DefaultRootWindow(display);
+        api.XSendEvent(display, root, False, SubstructureRedirectMask | SubstructureNotifyMask,
+                       &ev);
+        api.XFlush(display);
+        return true;
+    }
+
+    // Startup notification ids handed over by launchers end with "_TIME<timestamp>", which is
+    // the user time of the action that caused the launch.
+    static unsigned long timestampFromStartupId(const QString &startupId) {
+        auto idx = startupId.lastIndexOf(QStringLiteral("_TIME"));
+        if (idx < 0) {
+            return 0;
+        }
+        bool ok = false;
+        auto time = startupId.mid(idx + 5).toULong(&ok);
+        return ok ? time : 0;
+    }
+
     void LinuxX11Context::virtual_hook(int id, void *data) {
-        if (id == ShowSystemMenuHook) {
-            auto *x11app = qApp->nativeInterface<QNativeInterface::QX11Application>();
-            if (!x11app) {
+        switch (id) {
+            case RaiseWindowHook: {
+                if (!m_windowId)
+                    return;
+
+                auto *x11app = qApp->nativeInterface<QNativeInterface::QX11Application>();
+                auto display = x11app ? x11app->display() : nullptr;
+                if (!display) {
+                    break;
+                }
+
+                m_delegate->setWindowVisible(m_host, true);
+                Qt::WindowStates state = m_delegate->getWindowState(m_host);
+                if (state & Qt::WindowMinimized) {
+                    m_delegate->setWindowState(m_host, state & ~Qt::WindowMinimized);
+                }
+
+                // Focus stealing prevention compares the timestamp of the request with the
+                // user time of the active window, so pass the most recent user interaction we
+                // know about instead of CurrentTime, which many WMs treat as suspicious.
+                unsigned long timestamp = 0;
+                if (auto token = static_cast<const QString *>(data)) {
+                    timestamp = timestampFromStartupId(*token);
+                }
+                if (!timestamp) {
+                    auto ni = QGuiApplication::platformNativeInterface();
+                    auto screen = m_windowHandle->screen();
+                    timestamp = quintptr(ni->nativeResourceForScreen("appusertime", screen));
+                    if (!timestamp) {
+                        timestamp = quintptr(ni->nativeResourceForScreen("apptime", screen));
+                    }
+                }
+
+                // The window manager ignores the activation of a window that is not mapped yet,
+                // send the request once the window has been exposed.
+                if (!m_windowHandle->isExposed()) {
+                    m_activationPending = true;
+                    m_activationTimestamp = timestamp;
+                    return;
+                }
+                m_activationPending = false;
+                if (!activateWindow(timestamp)) {
+                    break;
+                }
+                m_delegate->bringWindowToTop(m_host);
                 return;
             }
 
-            auto display = x11app->display();
-            if (!display) {
+            case ShowSystemMenuHook: {
+                auto *x11app = qApp->nativeInterface<QNativeInterface::QX11Application>();
+                if (!x11app) {
+                    return;
+                }
+
+                auto display = x11app->display();
+                if (!display) {
+                    return;
+                }
+
+                const auto &api = QWK::Private::x11API();
+                Q_ASSERT(api.isValid());
+
+                auto pos = static_cast<const QPoint *>(data);
+                qreal dpr = m_windowHandle->devicePixelRatio();
+                int root_x = qRound(pos->x() * dpr);
+                int root_y = qRound(pos->y() * dpr);
+
+                // right button
+                constexpr auto Button3 = 3;
+                const long msg[5] = {Button3, root_x, root_y, 0, 0};
+
+                // use window id (XID)
+                api.XUngrabPointer(display, 0L);
+                std::ignore = sendRootClientMessage(display, static_cast<Window>(m_windowId),
+                                                    "_GTK_SHOW_WINDOW_MENU", msg);
                 return;
             }
 
-            const auto &api = QWK::Private::x11API();
-            Q_ASSERT(api.isValid());
+            default:
+                break;
+        }
+        QtWindowContext::virtual_hook(id, data);
+    }
 
-            // some marcos to constexpr in X11
-            constexpr auto None = 0L;
-            constexpr auto ClientMessage = 33;
-            constexpr auto False = 0;
-            constexpr auto Button3 = 3;
-            constexpr auto SubstructureNotifyMask = 1L << 19;
-            constexpr auto SubstructureRedirectMask = 1L << 20;
-
-            // use window id (XID)
-            auto xwin = static_cast<Window>(m_windowId);
-            Atom atom = api.XInternAtom(display, "_GTK_SHOW_WINDOW_MENU", False);
-            if (atom == None)
-                return; // WM might not support this atom
-            auto pos = static_cast<const QPoint *>(data);
-            XEvent ev{};
-            ev.xclient.type = ClientMessage;
-            ev.xclient.window = xwin;
-            ev.xclient.message_type = atom;
-
-            // The format member is set to 8, 16, or 32
-            // and specifies whether the data should be viewed as
-            // a list of bytes, shorts, or longs - typeof(xclient.data).
-            ev.xclient.format = 32;
-
-            qreal dpr = m_windowHandle->devicePixelRatio();
-            int root_x = qRound(pos->x() * dpr);
-            int root_y = qRound(pos->y() * dpr);
-
-            ev.xclient.data.l[0] = Button3; // right button
-            ev.xclient.data.l[1] = root_x;
-            ev.xclient.data.l[2] = root_y;
-
-            Window root = DefaultRootWindow(display);
-            api.XUngrabPointer(display, 0L);
-            api.XSendEvent(display, root, False, SubstructureRedirectMask | SubstructureNotifyMask,
-                           &ev);
-            api.XFlush(display);
+    bool LinuxX11Context::eventFilter(QObject *obj, QEvent *event) {
+        // Qt doesn't notify mask changes, compare the mask whenever the window is about to be
+        // drawn. An unchanged mask shares its data, so the comparison is cheap.
+        if (obj == m_windowHandle && m_blurEnabled &&
+            (event->type() == QEvent::Resize || event->type() == QEvent::Expose ||
+             event->type() == QEvent::UpdateRequest) &&
+            m_windowHandle->mask() != m_blurMask) {
+            std::ignore = updateBlurRegion();
+        }
+        if (obj == m_windowHandle && m_activationPending && event->type() == QEvent::Expose &&
+            m_windowHandle->isExposed()) {
+            m_activationPending = false;
+            std::ignore = activateWindow(m_activationTimestamp);
+            m_delegate->bringWindowToTop(m_host);
+        }
+        return QtWindowContext::eventFilter(obj, event);
+    }
+
+    void LinuxX11Context::winIdChanged(WId winId, WId oldWinId) {
+        QtWindowContext::winIdChanged(winId, oldWinId);
+
+        // The properties went away with the old window, the attributes will be applied again.
+        m_blurApplied = false;
+        m_blurMask = {};
+        m_blurRegion = {};
+        m_sizeHintsApplied = false;
+        std::ignore = updateSizeHints();
+    }
+
+    bool LinuxX11Context::windowAttributeChanged(const QString &key, const QVariant &attribute,
+                                                 const QVariant &oldAttribute) {
+        Q_ASSERT(m_windowId);
+
+        if (key == QStringLiteral("blur-effect")) {
+            bool enabled;
+            if (!Private::blurEffectEnabled(attribute, &enabled)) {
+                return false;
+            }
+            m_blurEnabled = enabled;
+            return updateBlurRegion();
+        }
+        if (key == QStringLiteral("aspect-ratio")) {
+            if (!QtWindowContext::windowAttributeChanged(key, attribute, oldAttribute)) {
+                return false;
+            }
+            std::ignore = updateSizeHints();
+            return true;
+        }
+        return QtWindowContext::windowAttributeChanged(key, attribute, oldAttribute);
+    }
+
+    bool LinuxX11Context::activateWindow(unsigned long timestamp) {
+        auto *x11app = qApp->nativeInterface<QNativeInterface::QX11Application>();
+        auto display = x11app ? x11app->display() : nullptr;
+        if (!m_windowId || !display) {
+            return false;
+        }
+
+        Window activeWindow = 0;
+        if (auto focusWindow = QGuiApplication::focusWindow()) {
+            activeWindow = static_cast<Window>(focusWindow->winId());
+        }
+
+        // https://specifications.freedesktop.org/wm-spec/latest/ar01s03.html#id-1.4.10
+        // Source indication 1 means the request comes from a normal application.
+        const long msg[5] = {1, long(timestamp), long(activeWindow), 0, 0};
+        return sendRootClientMessage(display, static_cast<Window>(m_windowId),
+                                     "_NET_ACTIVE_WINDOW", msg);
+    }
+
+    bool LinuxX11Context::updateBlurRegion() {
+        if (!m_windowId) {
+            return false;
+        }
+
+        const auto &api = QWK::Private::x11API();
+        auto *x11app = qApp->nativeInterface<QNativeInterface::QX11Application>();
+        auto display = x11app ? x11app->display() : nullptr;
+        if (!display || !api.canChangeProperties()) {
+            return false;
+        }
+
+        // some marcos to constexpr in X11
+        constexpr auto None = 0L;
+        constexpr auto False = 0;
+        constexpr auto XA_CARDINAL = Atom(6);
+        constexpr auto PropModeReplace = 0;
+
+        // https://invent.kde.org/plasma/kwin/-/blob/master/src/plugins/blur/blur.cpp
+        // The property holds x, y, width and height of each rectangle in device pixels, an empty
+        // list blurs the whole window.
+        Atom atom = api.XInternAtom(display, "_KDE_NET_WM_BLUR_BEHIND_REGION", False);
+        if (atom == None) {
+            return false;
+        }
+
+        const auto xwin = static_cast<Window>(m_windowId);
+        if (!m_blurEnabled) {
+            if (m_blurApplied) {
+                api.XDeleteProperty(display, xwin, atom);
+                api.XFlush(display);
+                m_blurApplied = false;
+                m_blurMask = {};
+                m_blurRegion = {};
+            }
+            return true;
+        }
+
+        // Follow the shape of the window if it has one
+        QRegion region;
+        const QRegion mask = m_windowHandle->mask();
+        const qreal dpr = m_windowHandle->devicePixelRatio();
+        for (const QRect &rect : mask) {
+            region += QRectF(rect.x() * dpr, rect.y() * dpr, rect.width() * dpr,
+                             rect.height() * dpr)
+                          .toAlignedRect();
+        }
+        m_blurMask = mask;
+        if (m_blurApplied && region == m_blurRegion) {
+            return true;
+        }
+
+        QVector<long> data;
+        data.reserve(region.rectCount() * 4);
+        for (const QRect &rect : region) {
+            data << rect.x() << rect.y() << rect.width() << rect.height();
+        }
+        api.XChangeProperty(display, xwin, atom, XA_CARDINAL, 32, PropModeReplace,
+                            reinterpret_cast<const unsigned char *>(data.constData()),
+                            int(data.size()));
+        api.XFlush(display);
+        m_blurApplied = true;
+        m_blurRegion = region;
+        return true;
+    }
+
+    bool LinuxX11Context::updateSizeHints() {
+        if (!m_windowId) {
+            return false;
+        }
+        // Nothing to add or to take back
+        if (m_aspectRatio <= 0 && !m_sizeHintsApplied) {
+            m_sizeHintsFilter.reset();
+            return true;
+        }
+
+        const auto &api = QWK::Private::x11API();
+        auto *x11app = qApp->nativeInterface<QNativeInterface::QX11Application>();
+        auto display = x11app ? x11app->display() : nullptr;
+        if (!display || !api.canChangeProperties() || !api.canReadProperties()) {
+            return false;
+        }
+
+        // Qt writes the property again without the aspect fields whenever it propagates the size
+        // hints, patch them back in each time the property changes.
+        if (m_aspectRatio > 0) {
+            if (!m_sizeHintsFilter) {
+                m_sizeHintsFilter = std::make_unique<SizeHintsEventFilter>(this);
+            }
         } else {
-            QtWindowContext::virtual_hook(id, data);
+            m_sizeHintsFilter.reset();
+        }
+
+        // some marcos to constexpr in X11
+        constexpr auto None = 0L;
+        constexpr auto False = 0;
+        constexpr auto Success = 0;
+        constexpr auto PropModeReplace = 0;
+        constexpr auto XA_WM_NORMAL_HINTS = Atom(40);
+        constexpr auto XA_WM_SIZE_HINTS = Atom(41);
+        constexpr auto PAspect = 1L << 7;
+
+        // Qt owns WM_NORMAL_HINTS and keeps the position, the sizes, the increments and the
+        // gravity in it, only the aspect fields are ours. Keep the rest as they are.
+        const auto xwin = static_cast<Window>(m_windowId);
+        long hints[kSizeHintsFieldCount] = {};
+        Atom actualType = None;
+        int actualFormat = 0;
+        unsigned long count = 0;
+        unsigned long remaining = 0;
+        unsigned char *data = nullptr;
+        if (api.XGetWindowProperty(display, xwin, XA_WM_NORMAL_HINTS, 0, kSizeHintsFieldCount,
+                                   False, XA_WM_SIZE_HINTS, &actualType, &actualFormat, &count,
+                                   &remaining, &data) == Success &&
+            data) {
+            if (actualType == XA_WM_SIZE_HINTS && actualFormat == 32) {
+                count = qMin<unsigned long>(count, kSizeHintsFieldCount);
+                std::memcpy(hints, data, count * sizeof(long));
+            }
+            api.XFree(data);
         }
+
+        // The ratio doesn't depend on the scale, a fixed denominator keeps enough precision.
+        // Our own write comes back as a property change too, it finds the fields in place.
+        const bool hasAspect = hints[0] & PAspect;
+        if (m_aspectRatio > 0) {
+            const long den = 10000;
+            const long num = qRound(m_aspectRatio * den);
+            m_sizeHintsApplied = true;
+            if (hasAspect && hints[11] == num && hints[12] == den && hints[13] == num &&
+                hints[14] == den) {
+                return true;
+            }
+            hints[0] |= PAspect;
+            hints[11] = hints[13] = num;
+            hints[12] = hints[14] = den;
+        } else {
+            m_sizeHintsApplied = false;
+            if (!hasAspect) {
+                return true;
+            }
+            hints[0] &= ~PAspect;
+            hints[11] = hints[12] = hints[13] = hints[14] = 0;
+        }
+
+        api.XChangeProperty(display, xwin, XA_WM_NORMAL_HINTS, XA_WM_SIZE_HINTS, 32,
+                            PropModeReplace, reinterpret_cast<const unsigned char *>(hints),
+                            kSizeHintsFieldCount);
+        api.XFlush(display);
+        return true;
     }
 }
 #endif // QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
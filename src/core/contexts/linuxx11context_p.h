@@ -28,6 +28,29 @@ namespace QWK {
 
         QString key() const override;
         void virtual_hook(int id, void *data) override;
+
+    protected:
+        bool eventFilter(QObject *obj, QEvent *event) override;
+
+        void winIdChanged(WId winId, WId oldWinId) override;
+        bool windowAttributeChanged(const QString &key, const QVariant &attribute,
+                                    const QVariant &oldAttribute) override;
+
+    protected:
+        bool m_blurEnabled = false;
+        bool m_blurApplied = false;
+        QRegion m_blurMask;
+        QRegion m_blurRegion;
+        bool m_activationPending = false;
+        unsigned long m_activationTimestamp = 0;
+        bool m_sizeHintsApplied = false;
+        std::unique_ptr<AppNativeEventFilter> m_sizeHintsFilter;
+
+        bool activateWindow(unsigned long timestamp);
+        bool updateBlurRegion();
+        bool updateSizeHints();
+
+        friend class SizeHintsEventFilter;
     };
 
 }
@@ -13,77 +13,26 @@ namespace QWK {
 
     static constexpr const quint8 kDefaultResizeBorderThickness = 8;
 
-    static Qt::CursorShape calculateCursorShape(const QWindow *window, const QPoint &pos) {
-#ifdef Q_OS_MACOS
-        Q_UNUSED(window);
-        Q_UNUSED(pos);
-        return Qt::ArrowCursor;
-#else
-        Q_ASSERT(window);
-        if (!window) {
-            return Qt::ArrowCursor;
-        }
-        if (window->visibility() != QWindow::Windowed) {
-            return Qt::ArrowCursor;
-        }
-        const int x = pos.x();
-        const int y = pos.y();
-        const int w = window->width();
-        const int h = window->height();
-        if (((x < kDefaultResizeBorderThickness) && (y < kDefaultResizeBorderThickness)) ||
-            ((x >= (w - kDefaultResizeBorderThickness)) &&
-             (y >= (h - kDefaultResizeBorderThickness)))) {
-            return Qt::SizeFDiagCursor;
-        }
-        if (((x >= (w - kDefaultResizeBorderThickness)) && (y < kDefaultResizeBorderThickness)) ||
-            ((x < kDefaultResizeBorderThickness) && (y >= (h - kDefaultResizeBorderThickness)))) {
-            return Qt::SizeBDiagCursor;
+    static inline Qt::CursorShape calculateCursorShape(Qt::Edges edges) {
+        const bool horizontal = bool(edges & (Qt::LeftEdge | Qt::RightEdge));
+        const bool vertical = bool(edges & (Qt::TopEdge | Qt::BottomEdge));
+        if (horizontal && vertical) {
+            return (edges.testFlag(Qt::LeftEdge) == edges.testFlag(Qt::TopEdge))
+                       ? Qt::SizeFDiagCursor
+                       : Qt::SizeBDiagCursor;
         }
-        if ((x < kDefaultResizeBorderThickness) || (x >= (w - kDefaultResizeBorderThickness))) {
+        if (horizontal) {
             return Qt::SizeHorCursor;
         }
-        if ((y < kDefaultResizeBorderThickness) || (y >= (h - kDefaultResizeBorderThickness))) {
+        if (vertical) {
             return Qt::SizeVerCursor;
         }
         return Qt::ArrowCursor;
-#endif
-    }
-
-    static inline Qt::Edges calculateWindowEdges(const QWindow *window, const QPoint &pos) {
-#ifdef Q_OS_MACOS
-        Q_UNUSED(window);
-        Q_UNUSED(pos);
-        return {};
-#else
-        Q_ASSERT(window);
-        if (!window) {
-            return {};
-        }
-        if (window->visibility() != QWindow::Windowed) {
-            return {};
-        }
-        Qt::Edges edges = {};
-        const int x = pos.x();
-        const int y = pos.y();
-        if (x < kDefaultResizeBorderThickness) {
-            edges |= Qt::LeftEdge;
-        }
-        if (x >= (window->width() - kDefaultResizeBorderThickness)) {
-            edges |= Qt::RightEdge;
-        }
-        if (y < kDefaultResizeBorderThickness) {
-            edges |= Qt::TopEdge;
-        }
-        if (y >= (window->height() - kDefaultResizeBorderThickness)) {
-            edges |= Qt::BottomEdge;
-        }
-        return edges;
-#endif
     }
 
     class QtWindowEventFilter : public SharedEventFilter {
     public:
-        explicit QtWindowEventFilter(AbstractWindowContext *context);
+        explicit QtWindowEventFilter(QtWindowContext *context);
         ~QtWindowEventFilter() override;
 
         enum WindowStatus {
@@ -97,19 +46,27 @@ namespace QWK {
     protected:
         bool sharedEventFilter(QObject *object, QEvent *event) override;
 
+        void setWindowStatus(WindowStatus status);
+
     private:
-        AbstractWindowContext *m_context;
+        QtWindowContext *m_context;
         bool m_cursorShapeChanged;
         WindowStatus m_windowStatus;
     };
 
-    QtWindowEventFilter::QtWindowEventFilter(AbstractWindowContext *context)
+    QtWindowEventFilter::QtWindowEventFilter(QtWindowContext *context)
         : m_context(context), m_cursorShapeChanged(false), m_windowStatus(Idle) {
         m_context->installSharedEventFilter(this);
     }
 
     QtWindowEventFilter::~QtWindowEventFilter() = default;
 
+    void QtWindowEventFilter::setWindowStatus(WindowStatus status) {
+        m_windowStatus = status;
+        m_context->setMoving(status == Moving);
+        m_context->setResizing(status == Resizing);
+    }
+
     bool QtWindowEventFilter::sharedEventFilter(QObject *obj, QEvent *event) {
         Q_UNUSED(obj)
 
@@ -126,20 +83,37 @@ namespace QWK {
         QPoint scenePos = getMouseEventScenePos(me);
         QPoint globalPos = getMouseEventGlobalPos(me);
 
-        bool inTitleBar = m_context->isInTitleBarDraggableArea(scenePos);
+        WindowHitTestFrame frame;
+        frame.size = window->size();
+#ifndef Q_OS_MACOS
+        // The system frame of macOS is kept, it resizes the window by itself.
+        const QMargins borders(kDefaultResizeBorderThickness, kDefaultResizeBorderThickness,
+                               kDefaultResizeBorderThickness, kDefaultResizeBorderThickness);
+        frame.resizeBorders = borders;
+        frame.buttonResizeBorders = borders;
+#endif
+        const auto &windowCache = m_context->windowCache();
+        frame.windowState = windowCache.states;
+        frame.fixedWidth = windowCache.fixedWidth;
+        frame.fixedHeight = windowCache.fixedHeight;
+
+        const WindowHitTestResult hit = m_context->hitTest(scenePos, scenePos, frame);
+        const Qt::Edges edges =
+            hit.part == WindowHitTestResult::ResizeBorder ? hit.edges : Qt::Edges();
+        bool inTitleBar = hit.part == WindowHitTestResult::TitleBar;
 
         const auto& updateCursorShape{ [&](){
             if (fixedSize) {
                 return;
             }
-            const Qt::CursorShape shape = calculateCursorShape(window, scenePos);
+            const Qt::CursorShape shape = calculateCursorShape(edges);
             if (shape == Qt::ArrowCursor) {
                 if (m_cursorShapeChanged) {
-                    delegate->restoreCursorShape(host);
+                    m_context->restoreCursorShape();
                     m_cursorShapeChanged = false;
                 }
             } else {
-                delegate->setCursorShape(host, shape);
+                m_context->setCursorShape(shape);
                 m_cursorShapeChanged = true;
             }
         } };
@@ -148,23 +122,21 @@ namespace QWK {
 
         switch (type) {
             case QEvent::MouseButtonPress: {
-                m_windowStatus = WaitingRelease;
+                setWindowStatus(WaitingRelease);
                 switch (me->button()) {
                     case Qt::LeftButton: {
-                        if (!fixedSize) {
-                            Qt::Edges edges = calculateWindowEdges(window, scenePos);
-                            if (edges != Qt::Edges()) {
-                                startSystemResize(window, edges);
-                                m_windowStatus = Resizing;
-                                handled = true;
-                                break;
-                            }
+                        if (edges != Qt::Edges()) {
+                            startSystemResize(window, edges, m_context->pointerPredictor(),
+                                              m_context->aspectRatio());
+                            setWindowStatus(Resizing);
+                            handled = true;
+                            break;
                         }
                         if (inTitleBar) {
                             // If we call startSystemMove() now but release the mouse without actual
                             // movement, there will be no MouseReleaseEvent, so we defer it when the
                             // mouse is actually moving for the first time
-                            m_windowStatus = PreparingMove;
+                            setWindowStatus(PreparingMove);
                             handled = true;
                         }
                         break;
@@ -172,7 +144,7 @@ namespace QWK {
                     case Qt::RightButton: {
                         if (inTitleBar) {
                             m_context->showSystemMenu(globalPos);
-                            m_windowStatus = Idle;
+                            setWindowStatus(Idle);
                             handled = true;
                         }
                         break;
@@ -200,7 +172,7 @@ namespace QWK {
                         break;
                     }
                 }
-                m_windowStatus = Idle;
+                setWindowStatus(Idle);
                 break;
             }
 
@@ -212,13 +184,21 @@ namespace QWK {
                         break;
                     }
                     case PreparingMove: {
-                        startSystemMove(window);
-                        m_windowStatus = Moving;
+                        startSystemMove(window, false, m_context->pointerPredictor());
+                        setWindowStatus(Moving);
                         handled = true;
                         break;
                     }
                     case Moving:
                     case Resizing: {
+                        if (!(me->buttons() & Qt::LeftButton)) {
+                            // The system move or resize has ended without giving the release
+                            // back, leave the state here so that the moving and resizing
+                            // properties of the agent don't stay set until the next press
+                            setWindowStatus(Idle);
+                            updateCursorShape();
+                            break;
+                        }
                         handled = true;
                         break;
                     }
@@ -228,8 +208,8 @@ namespace QWK {
 
             case QEvent::MouseButtonDblClick: {
                 if (me->button() == Qt::LeftButton && inTitleBar && !fixedSize) {
-                    Qt::WindowFlags windowFlags = delegate->getWindowFlags(host);
-                    Qt::WindowStates windowState = delegate->getWindowState(host);
+                    Qt::WindowFlags windowFlags = m_context->windowCache().flags;
+                    Qt::WindowStates windowState = m_context->windowCache().states;
                     if ((windowFlags & Qt::WindowMaximizeButtonHint) &&
                         !(windowState & Qt::WindowFullScreen)) {
                         if (windowState & Qt::WindowMaximized) {
@@ -269,6 +249,14 @@ namespace QWK {
         AbstractWindowContext::virtual_hook(id, data);
     }
 
+    void QtWindowContext::setCursorShape(Qt::CursorShape shape) {
+        m_delegate->setCursorShape(m_host, shape);
+    }
+
+    void QtWindowContext::restoreCursorShape() {
+        m_delegate->restoreCursorShape(m_host);
+    }
+
     void QtWindowContext::winIdChanged(WId winId, WId oldWinId) {
         if (!m_windowHandle) {
             m_delegate->setWindowFlags(m_host, m_delegate->getWindowFlags(m_host) &
@@ -27,6 +27,11 @@ namespace QWK {
         QString key() const override;
         void virtual_hook(int id, void *data) override;
 
+        // Used for the resize cursors of the emulated frame, the platform may set them more
+        // cheaply than the delegate.
+        virtual void setCursorShape(Qt::CursorShape shape);
+        virtual void restoreCursorShape();
+
     protected:
         void winIdChanged(WId winId, WId oldWinId) override;
 
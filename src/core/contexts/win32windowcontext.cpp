@@ -72,6 +72,14 @@ namespace QWK {
     // Original Qt window proc function
     static WNDPROC g_qtWindowProc = nullptr;
 
+    // Forwarded child hWnd -> its original window proc and the context of its top level window
+    struct ForwardedChildWindow {
+        WNDPROC windowProc;
+        Win32WindowContext *ctx;
+    };
+    using ChildWndProcHash = QHash<HWND, ForwardedChildWindow>;
+    Q_GLOBAL_STATIC(ChildWndProcHash, g_childWndProcHash)
+
     static inline bool
 #if !QWINDOWKIT_CONFIG(ENABLE_WINDOWS_SYSTEM_BORDERS)
         constexpr
@@ -505,18 +513,16 @@ namespace QWK {
     // handles Windows window messages in the main thread, it is safe to do so.
     class WindowsNativeEventFilter : public AppNativeEventFilter {
     public:
-        bool nativeEventFilter(const QByteArray &eventType, void *message,
+        bool nativeEventFilter(const NativeEvent &event, void *message,
                                QT_NATIVE_EVENT_RESULT_TYPE *result) override {
-            Q_UNUSED(eventType)
-
             // It has been observed that the pointer that Qt gives us is sometimes null on some
             // machines. We need to guard against it in such scenarios.
-            if (!result || !message) {
+            if (event.type != NativeEvent::WindowsMessage || !result) {
                 return false;
             }
 
             auto msg = static_cast<const MSG *>(message);
-            switch (msg->message) {
+            switch (event.messageType) {
                 case WM_NCCALCSIZE: {
                     // https://github.com/qt/qtbase/blob/e26a87f1ecc40bc8c6aa5b889fce67410a57a702/src/plugins/platforms/windows/qwindowscontext.cpp#L1546
                     // Qt needs to refer to the WM_NCCALCSIZE message data that hasn't been
@@ -659,6 +665,79 @@ namespace QWK {
         return ::CallWindowProcW(g_qtWindowProc, hWnd, message, wParam, lParam);
     }
 
+    // A native child window receives the mouse messages of its area directly. Answering its hit
+    // tests with HTTRANSPARENT over draggable space makes the system ask the top level window
+    // instead, which then handles dragging and the system menu as if there was no child at all.
+    extern "C" LRESULT QT_WIN_CALLBACK QWKForwardedChildWndProc(HWND hWnd, UINT message,
+                                                                WPARAM wParam, LPARAM lParam) {
+        Q_ASSERT(hWnd);
+        if (!hWnd) {
+            return FALSE;
+        }
+
+        auto it = g_childWndProcHash->constFind(hWnd);
+        if (it == g_childWndProcHash->constEnd()) {
+            return ::DefWindowProcW(hWnd, message, wParam, lParam);
+        }
+        const ForwardedChildWindow child = it.value();
+
+        switch (message) {
+            case WM_NCHITTEST: {
+                POINT nativeGlobalPos{GET_X_LPARAM(lParam), GET_Y_LPARAM(lParam)};
+                if (child.ctx->isForwardedChildHit(nativeGlobalPos)) {
+                    return HTTRANSPARENT;
+                }
+                break;
+            }
+            case WM_NCDESTROY: {
+                ::SetWindowLongPtrW(hWnd, GWLP_WNDPROC,
+                                    reinterpret_cast<LONG_PTR>(child.windowProc));
+                g_childWndProcHash->remove(hWnd);
+                break;
+            }
+            default:
+                break;
+        }
+        return ::CallWindowProcW(child.windowProc, hWnd, message, wParam, lParam);
+    }
+
+    static inline bool addForwardedChildWindow(HWND hWnd, Win32WindowContext *ctx) {
+        Q_ASSERT(hWnd);
+        Q_ASSERT(ctx);
+
+        if (g_childWndProcHash->contains(hWnd)) {
+            return true;
+        }
+
+        // The window proc of a window of another process can't be replaced, and HTTRANSPARENT
+        // only passes the hit test on to windows of the same thread.
+        DWORD processId = 0;
+        DWORD threadId = ::GetWindowThreadProcessId(hWnd, &processId);
+        if (processId != ::GetCurrentProcessId() || threadId != ::GetCurrentThreadId()) {
+            return false;
+        }
+
+        ::SetLastError(ERROR_SUCCESS);
+        auto windowProc = reinterpret_cast<WNDPROC>(::SetWindowLongPtrW(
+            hWnd, GWLP_WNDPROC, reinterpret_cast<LONG_PTR>(QWKForwardedChildWndProc)));
+        if (!windowProc && ::GetLastError() != ERROR_SUCCESS) {
+            return false;
+        }
+        g_childWndProcHash->insert(hWnd, {windowProc, ctx});
+        return true;
+    }
+
+    static inline void removeForwardedChildWindow(HWND hWnd) {
+        Q_ASSERT(hWnd);
+
+        auto it = g_childWndProcHash->find(hWnd);
+        if (it == g_childWndProcHash->end()) {
+            return;
+        }
+        ::SetWindowLongPtrW(hWnd, GWLP_WNDPROC, reinterpret_cast<LONG_PTR>(it->windowProc));
+        g_childWndProcHash->erase(it);
+    }
+
     static inline void addManagedWindow(QWindow *window, HWND hWnd, Win32WindowContext *ctx) {
         Q_ASSERT(window);
         Q_ASSERT(hWnd);
@@ -705,6 +784,15 @@ namespace QWK {
     Win32WindowContext::Win32WindowContext() = default;
 
     Win32WindowContext::~Win32WindowContext() {
+        for (auto it = g_childWndProcHash->begin(); it != g_childWndProcHash->end();) {
+            if (it->ctx == this) {
+                ::SetWindowLongPtrW(it.key(), GWLP_WNDPROC,
+                                    reinterpret_cast<LONG_PTR>(it->windowProc));
+                it = g_childWndProcHash->erase(it);
+            } else {
+                ++it;
+            }
+        }
         if (m_windowId) {
             removeManagedWindow(reinterpret_cast<HWND>(m_windowId));
         }
@@ -751,6 +839,38 @@ namespace QWK {
                 return;
             }
 
+            case MoveAttachedWindowsHook: {
+                // Move all the windows in one go, so that they are repositioned together by the
+                // desktop window manager, in the same frame.
+                const auto &windows = *static_cast<const WindowPositionList *>(data);
+                HDWP hdwp = ::BeginDeferWindowPos(int(windows.size()));
+                if (!hdwp) {
+                    break;
+                }
+                for (const auto &item : windows) {
+                    QWindow *window = item.first;
+                    if (!window->handle()) {
+                        continue;
+                    }
+                    const auto hwnd = reinterpret_cast<HWND>(window->winId());
+                    RECT rect{};
+                    ::GetWindowRect(hwnd, &rect);
+                    // The frame position is not known to Qt before the window is shown, move by
+                    // the difference instead
+                    const QPoint delta =
+                        (item.second - window->position()) * QHighDpiScaling::factor(window);
+                    hdwp = ::DeferWindowPos(hdwp, hwnd, nullptr, rect.left + delta.x(),
+                                            rect.top + delta.y(), 0, 0,
+                                            SWP_NOSIZE | SWP_NOZORDER | SWP_NOACTIVATE |
+                                                SWP_NOOWNERZORDER);
+                    if (!hdwp) {
+                        return;
+                    }
+                }
+                ::EndDeferWindowPos(hdwp);
+                return;
+            }
+
 #if QWINDOWKIT_CONFIG(ENABLE_WINDOWS_SYSTEM_BORDERS)
             // ### FIXME: May be deprecated
             case DrawWindows10BorderHook_Emulated: {
@@ -912,6 +1032,37 @@ namespace QWK {
         addManagedWindow(m_windowHandle, hWnd, this);
     }
 
+    bool Win32WindowContext::childWindowForwardingChanged(QWindow *window, bool forwarded) {
+        // The child window gets its messages before Qt does, so it is hooked natively instead of
+        // watching its Qt events. The Qt events are still watched to hook the new native window
+        // whenever the child is recreated.
+        auto hWnd = reinterpret_cast<HWND>(window->winId());
+        if (!hWnd) {
+            return false;
+        }
+        if (forwarded) {
+            if (!addForwardedChildWindow(hWnd, this)) {
+                return false;
+            }
+        } else {
+            removeForwardedChildWindow(hWnd);
+        }
+        return AbstractWindowContext::childWindowForwardingChanged(window, forwarded);
+    }
+
+    bool Win32WindowContext::isForwardedChildHit(const POINT &nativeGlobalPos) const {
+        if (!m_windowId) {
+            return false;
+        }
+        POINT nativeLocalPos = nativeGlobalPos;
+        ::ScreenToClient(reinterpret_cast<HWND>(m_windowId), &nativeLocalPos);
+        QPoint qtScenePos = QHighDpi::fromNativeLocalPosition(point2qpoint(nativeLocalPos),
+                                                              m_windowHandle.data());
+        WindowAgentBase::SystemButton sysButtonType = WindowAgentBase::Unknown;
+        return isInTitleBarDraggableArea(qtScenePos) ||
+               isInSystemButtons(qtScenePos, &sysButtonType);
+    }
+
     bool Win32WindowContext::windowProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam,
                                         LRESULT *result) {
         Q_ASSERT(hWnd);
@@ -937,6 +1088,39 @@ namespace QWK {
             return false;
         }
 
+        // Follow the modal move and resize loop of the system for the agent state
+        switch (message) {
+            case WM_MOVING:
+                setMoving(true);
+                break;
+            case WM_SIZING:
+                setResizing(true);
+                break;
+            case WM_EXITSIZEMOVE:
+                setMoving(false);
+                setResizing(false);
+                break;
+            default:
+                break;
+        }
+
+        // The presses on the title bar and the borders never reach Qt as mouse events, refresh
+        // the cached window flags before they are handled
+        switch (message) {
+            case WM_NCLBUTTONDOWN:
+            case WM_NCLBUTTONDBLCLK:
+            case WM_NCRBUTTONDOWN:
+                updateWindowCache();
+                break;
+            case WM_STYLECHANGED:
+                // QWindow::setFlags() changes the style first and stores the flags afterwards
+                QMetaObject::invokeMethod(
+                    this, [this]() { updateWindowCache(); }, Qt::QueuedConnection);
+                break;
+            default:
+                break;
+        }
+
         // Test snap layout
         if (snapLayoutHandler(hWnd, message, wParam, lParam, result)) {
             return true;
@@ -955,8 +1139,14 @@ namespace QWK {
         // Forward to native event filter subscribers
         if (!m_nativeEventFilters.isEmpty()) {
             MSG msg = createMessageBlock(hWnd, message, wParam, lParam);
+            static const QByteArray eventType = nativeEventType();
+            NativeEvent event;
+            event.type = NativeEvent::WindowsMessage;
+            event.messageType = message;
+            event.windowId = reinterpret_cast<quintptr>(hWnd);
+            event.eventType = &eventType;
             QT_NATIVE_EVENT_RESULT_TYPE res = 0;
-            if (nativeDispatch(nativeEventType(), &msg, &res)) {
+            if (nativeDispatch(event, &msg, &res)) {
                 *result = LRESULT(res);
                 return true;
             }
@@ -1207,7 +1397,7 @@ namespace QWK {
             apis.pDwmSetWindowAttribute(hwnd, _DWMWA_BORDER_COLOR, &colorRef, sizeof(colorRef));
             return true;
         }
-        return false;
+        return AbstractWindowContext::windowAttributeChanged(key, attribute, oldAttribute);
     }
 
     QWK_USED static constexpr const struct {
@@ -1680,108 +1870,9 @@ namespace QWK {
                 QPoint qtScenePos = QHighDpi::fromNativeLocalPosition(point2qpoint(nativeLocalPos),
                                                                       m_windowHandle.data());
 
-                int frameSize = getResizeBorderThickness(hWnd);
-
                 bool isFixedWidth = isHostWidthFixed();
                 bool isFixedHeight = isHostHeightFixed();
                 bool isFixedSize = isHostSizeFixed();
-                bool isInLeftBorder = nativeLocalPos.x <= frameSize;
-                bool isInTopBorder = nativeLocalPos.y <= frameSize;
-                bool isInRightBorder = nativeLocalPos.x > clientWidth - frameSize;
-                bool isInBottomBorder = nativeLocalPos.y > clientHeight - frameSize;
-                bool isInTitleBar = isInTitleBarDraggableArea(qtScenePos);
-                WindowAgentBase::SystemButton sysButtonType = WindowAgentBase::Unknown;
-                bool isInCaptionButtons = isInSystemButtons(qtScenePos, &sysButtonType);
-                static constexpr bool dontOverrideCursor = false; // ### TODO
-
-                if (isInCaptionButtons) {
-                    // Firstly, we set the hit test result to a default value to be able to detect
-                    // whether we have changed it or not afterwards.
-                    *result = HTNOWHERE;
-                    // Even if the mouse is inside the chrome button area now, we should still allow
-                    // the user to be able to resize the window with the top or right window border,
-                    // this is also the normal behavior of a native Win32 window (but only when the
-                    // window is not maximized/fullscreen/minimized, of course).
-                    if (isWindowNoState(hWnd)) {
-                        static constexpr const quint8 kBorderSize = 2;
-                        bool isTop = nativeLocalPos.y <= kBorderSize;
-                        bool isLeft = nativeLocalPos.x <= kBorderSize;
-                        bool isRight = nativeLocalPos.x > clientWidth - kBorderSize;
-                        if (isTop || isLeft || isRight) {
-                            if (isFixedSize || dontOverrideCursor) {
-                                // The user doesn't want the window to be resized, so we tell
-                                // Windows we are in the client area so that the controls beneath
-                                // the mouse cursor can still be hovered or clicked.
-                                *result = isInTitleBar ? HTCAPTION : HTCLIENT;
-                            } else {
-                                if (isTop) {
-                                    if (isLeft) {
-                                        if (isFixedWidth) {
-                                            *result = HTTOP;
-                                        } else if (isFixedHeight) {
-                                            *result = HTLEFT;
-                                        } else {
-                                            *result = HTTOPLEFT;
-                                        }
-                                    } else if (isRight) {
-                                        if (isFixedWidth) {
-                                            *result = HTTOP;
-                                        } else if (isFixedHeight) {
-                                            *result = HTRIGHT;
-                                        } else {
-                                            *result = HTTOPRIGHT;
-                                        }
-                                    } else {
-                                        *result = isFixedHeight ? HTBORDER : HTTOP;
-                                    }
-                                } else {
-                                    if (isFixedWidth) {
-                                        *result = HTBORDER;
-                                    } else {
-                                        *result = isLeft ? HTLEFT : HTRIGHT;
-                                    }
-                                }
-                            }
-                        }
-                    }
-                    if (*result == HTNOWHERE) {
-                        // OK, we are now really inside one of the chrome buttons, tell Windows the
-                        // exact role of our button. The Snap Layout feature introduced in Windows
-                        // 11 won't work without this.
-                        switch (sysButtonType) {
-                            case WindowAgentBase::WindowIcon:
-                                *result = HTSYSMENU;
-                                break;
-                            case WindowAgentBase::Help:
-                                *result = HTHELP;
-                                break;
-                            case WindowAgentBase::Minimize:
-                                *result = HTREDUCE;
-                                break;
-                            case WindowAgentBase::Maximize:
-                                *result = HTZOOM;
-                                break;
-                            case WindowAgentBase::Close:
-                                *result = HTCLOSE;
-                                break;
-                            default:
-                                // unreachable
-                                break;
-                        }
-                    }
-                    if (*result == HTNOWHERE) {
-                        // OK, it seems we are not inside the window resize area, nor inside the
-                        // chrome buttons, tell Windows we are in the client area to let Qt handle
-                        // this event.
-                        *result = HTCLIENT;
-                    }
-                    return true;
-                }
-                // OK, we are not inside any chrome buttons, try to find out which part of the
-                // window are we hitting.
-
-                bool max = isMaximized(hWnd);
-                bool full = isFullScreen(hWnd);
 
                 if (isSystemBorderEnabled()) {
                     // This will handle the left, right and bottom parts of the frame
@@ -1796,7 +1887,7 @@ namespace QWK {
                         *result = HTNOWHERE; // Make sure we can know we don't set any value
                                              // explicitly later.
                         if (originalHitTestResult == HTCAPTION) {
-                        } else if (isFixedSize || dontOverrideCursor) {
+                        } else if (isFixedSize) {
                             *result = HTBORDER;
                         } else if (isFixedWidth || isFixedHeight) {
                             if (originalHitTestResult == HTTOPLEFT) {
@@ -1840,134 +1931,99 @@ namespace QWK {
                         }
                         return true;
                     }
-                    if (full) {
-                        *result = HTCLIENT;
-                        return true;
-                    }
-                    if (max) {
-                        *result = isInTitleBar ? HTCAPTION : HTCLIENT;
-                        return true;
-                    }
-                    // At this point, we know that the cursor is inside the client area,
-                    // so it has to be either the little border at the top of our custom
-                    // title bar or the drag bar. Apparently, it must be the drag bar or
-                    // the little border at the top which the user can use to move or
-                    // resize the window.
-                    if (isInTopBorder) {
-                        // Return HTCLIENT instead of HTBORDER here, because the mouse is
-                        // inside our homemade title bar now, return HTCLIENT to let our
-                        // title bar can still capture mouse events.
-                        *result = [&]() {
-                            if (isFixedSize || isFixedHeight || dontOverrideCursor ||
-                                (isFixedWidth && (isInLeftBorder || isInRightBorder))) {
-                                if (isInTitleBar) {
-                                    return HTCAPTION;
-                                } else {
-                                    return HTCLIENT;
-                                }
-                            } else {
-                                return HTTOP;
-                            }
-                        }();
-                        return true;
-                    }
-                    if (isInTitleBar) {
-                        *result = HTCAPTION;
-                        return true;
-                    }
-                    *result = HTCLIENT;
-                    return true;
+                }
+
+                // At this point the cursor is inside the client area, the shared engine decides
+                // which part of the window is hit and we only translate it. With the system
+                // borders, the left, right and bottom borders are outside of the client area, so
+                // only the little border at the top of our custom title bar is left to us.
+                // The borders reach from the left and top sides up to and including the
+                // thickness, and from the right and bottom sides up to but excluding it, i.e.
+                // x <= thickness and x > width - thickness.
+                WindowHitTestFrame frame;
+                frame.size = QSize(clientWidth, clientHeight);
+                const int frameSize = getResizeBorderThickness(hWnd);
+                if (isSystemBorderEnabled()) {
+                    frame.resizeBorders = QMargins(0, frameSize + 1, 0, 0);
+                    frame.topCornerLeft = frameSize + 1;
+                    frame.topCornerRight = frameSize - 1;
                 } else {
-                    if (full) {
-                        *result = HTCLIENT;
-                        return true;
-                    }
-                    if (max || isFixedSize || dontOverrideCursor) {
-                        *result = isInTitleBar ? HTCAPTION : HTCLIENT;
-                        return true;
-                    }
-                    if (isFixedWidth || isFixedHeight) {
-                        if (isInLeftBorder && isInTopBorder) {
-                            if (isFixedWidth) {
-                                *result = HTTOP;
-                            } else {
-                                *result = HTLEFT;
-                            }
-                        } else if (isInRightBorder && isInTopBorder) {
-                            if (isFixedWidth) {
-                                *result = HTTOP;
-                            } else {
-                                *result = HTRIGHT;
-                            }
-                        } else if (isInRightBorder && isInBottomBorder) {
-                            if (isFixedWidth) {
-                                *result = HTBOTTOM;
-                            } else {
-                                *result = HTRIGHT;
-                            }
-                        } else if (isInLeftBorder && isInBottomBorder) {
-                            if (isFixedWidth) {
-                                *result = HTBOTTOM;
-                            } else {
-                                *result = HTLEFT;
-                            }
-                        } else if (isInLeftBorder || isInRightBorder) {
-                            if (isFixedWidth) {
-                                *result = HTCLIENT;
-                            } else {
-                                *result = isInLeftBorder ? HTLEFT : HTRIGHT;
-                            }
-                        } else if (isInTopBorder || isInBottomBorder) {
-                            if (isFixedHeight) {
+                    frame.resizeBorders =
+                        QMargins(frameSize + 1, frameSize + 1, frameSize - 1, frameSize - 1);
+                }
+                // Even if the mouse is inside the chrome button area now, we should still allow
+                // the user to be able to resize the window with the top, left or right window
+                // border, this is also the normal behavior of a native Win32 window.
+                static constexpr const quint8 kBorderSize = 2;
+                frame.buttonResizeBorders =
+                    QMargins(kBorderSize + 1, kBorderSize + 1, kBorderSize - 1, 0);
+                if (isFullScreen(hWnd)) {
+                    frame.windowState = Qt::WindowFullScreen;
+                } else if (isMaximized(hWnd)) {
+                    frame.windowState = Qt::WindowMaximized;
+                } else if (isMinimized(hWnd)) {
+                    frame.windowState = Qt::WindowMinimized;
+                }
+                frame.fixedWidth = isFixedWidth;
+                frame.fixedHeight = isFixedHeight;
+
+                const WindowHitTestResult hit =
+                    hitTest(point2qpoint(nativeLocalPos), qtScenePos, frame);
+                switch (hit.part) {
+                    case WindowHitTestResult::SystemButton: {
+                        // Tell Windows the exact role of our button. The Snap Layout feature
+                        // introduced in Windows 11 won't work without this.
+                        switch (hit.button) {
+                            case WindowAgentBase::WindowIcon:
+                                *result = HTSYSMENU;
+                                break;
+                            case WindowAgentBase::Help:
+                                *result = HTHELP;
+                                break;
+                            case WindowAgentBase::Minimize:
+                                *result = HTREDUCE;
+                                break;
+                            case WindowAgentBase::Maximize:
+                                *result = HTZOOM;
+                                break;
+                            case WindowAgentBase::Close:
+                                *result = HTCLOSE;
+                                break;
+                            default:
+                                // Let Qt handle this event.
                                 *result = HTCLIENT;
-                            } else {
-                                *result = isInTopBorder ? HTTOP : HTBOTTOM;
-                            }
-                        } else {
-                            *result = HTCLIENT;
-                        }
-                        return true;
-                    } else {
-                        if (isInTopBorder) {
-                            if (isInLeftBorder) {
-                                *result = HTTOPLEFT;
-                                return true;
-                            }
-                            if (isInRightBorder) {
-                                *result = HTTOPRIGHT;
-                                return true;
-                            }
-                            *result = HTTOP;
-                            return true;
-                        }
-                        if (isInBottomBorder) {
-                            if (isInLeftBorder) {
-                                *result = HTBOTTOMLEFT;
-                                return true;
-                            }
-                            if (isInRightBorder) {
-                                *result = HTBOTTOMRIGHT;
-                                return true;
-                            }
-                            *result = HTBOTTOM;
-                            return true;
-                        }
-                        if (isInLeftBorder) {
-                            *result = HTLEFT;
-                            return true;
-                        }
-                        if (isInRightBorder) {
-                            *result = HTRIGHT;
-                            return true;
+                                break;
                         }
+                        break;
                     }
-                    if (isInTitleBar) {
-                        *result = HTCAPTION;
-                        return true;
+                    case WindowHitTestResult::ResizeBorder: {
+                        const Qt::Edges edges = hit.edges;
+                        if (edges & Qt::TopEdge) {
+                            *result = (edges & Qt::LeftEdge)    ? HTTOPLEFT
+                                      : (edges & Qt::RightEdge) ? HTTOPRIGHT
+                                                                : HTTOP;
+                        } else if (edges & Qt::BottomEdge) {
+                            *result = (edges & Qt::LeftEdge)    ? HTBOTTOMLEFT
+                                      : (edges & Qt::RightEdge) ? HTBOTTOMRIGHT
+                                                                : HTBOTTOM;
+                        } else {
+                            *result = (edges & Qt::LeftEdge) ? HTLEFT : HTRIGHT;
+                        }
+                        break;
                     }
-                    *result = HTCLIENT;
-                    return true;
+                    case WindowHitTestResult::FixedBorder:
+                        // Keep the button from being pressed by the border.
+                        *result = HTBORDER;
+                        break;
+                    case WindowHitTestResult::TitleBar:
+                        // A full screen window can't be moved
+                        *result = isFullScreen(hWnd) ? HTCLIENT : HTCAPTION;
+                        break;
+                    default:
+                        *result = HTCLIENT;
+                        break;
                 }
+                return true;
             }
 
             case WM_WINDOWPOSCHANGING: {
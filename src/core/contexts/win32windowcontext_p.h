@@ -44,8 +44,11 @@ namespace QWK {
         void winIdChanged(WId winId, WId oldWinId) override;
         bool windowAttributeChanged(const QString &key, const QVariant &attribute,
                                     const QVariant &oldAttribute) override;
+        bool childWindowForwardingChanged(QWindow *window, bool forwarded) override;
 
     public:
+        bool isForwardedChildHit(const POINT &nativeGlobalPos) const;
+
         bool windowProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam, LRESULT *result);
 
         bool systemMenuHandler(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam,
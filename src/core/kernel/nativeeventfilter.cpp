@@ -4,11 +4,88 @@
 
 #include "nativeeventfilter_p.h"
 
+#include <cstring>
+
 #include <QtCore/QAbstractNativeEventFilter>
 #include <QtCore/QCoreApplication>
 
+#ifdef Q_OS_WINDOWS
+#  include <QtCore/qt_windows.h>
+#endif
+
 namespace QWK {
 
+    // Offset of the window field of the core X11 events, the xcb event structures are not
+    // available at build time. Returns -1 if the event doesn't carry a window.
+    //
+    // Extension events arrive as GenericEvent (35), Qt 6 gets all its input from XInput 2 that
+    // way. Their layout depends on the extension, whose major opcode is only known once it has
+    // been queried from the server, so they are left without a window.
+    static inline int xcbWindowOffset(quint8 responseType) {
+        switch (responseType) {
+            case 2:  // KeyPress
+            case 3:  // KeyRelease
+            case 4:  // ButtonPress
+            case 5:  // ButtonRelease
+            case 6:  // MotionNotify
+            case 7:  // EnterNotify
+            case 8:  // LeaveNotify
+                return 12;
+            case 9:  // FocusIn
+            case 10: // FocusOut
+            case 12: // Expose
+            case 28: // PropertyNotify
+            case 33: // ClientMessage
+                return 4;
+            case 17: // DestroyNotify
+            case 18: // UnmapNotify
+            case 19: // MapNotify
+            case 21: // ReparentNotify
+            case 22: // ConfigureNotify
+                return 8;
+            default:
+                break;
+        }
+        return -1;
+    }
+
+    NativeEvent NativeEvent::classify(const QByteArray &eventType, void *message) {
+        NativeEvent event;
+        event.eventType = &eventType;
+        if (!message) {
+            return event;
+        }
+
+        if (eventType == QByteArrayLiteral("xcb_generic_event_t")) {
+            const auto data = static_cast<const quint8 *>(message);
+            const quint8 responseType = data[0] & ~0x80;
+            event.type = XcbEvent;
+            event.messageType = responseType;
+            if (int offset = xcbWindowOffset(responseType); offset >= 0) {
+                quint32 window;
+                std::memcpy(&window, data + offset, sizeof(window));
+                event.windowId = window;
+            }
+            return event;
+        }
+
+#ifdef Q_OS_WINDOWS
+        if (eventType == QByteArrayLiteral("windows_generic_MSG") ||
+            eventType == QByteArrayLiteral("windows_dispatcher_MSG")) {
+            const auto msg = static_cast<const MSG *>(message);
+            event.type = WindowsMessage;
+            event.messageType = msg->message;
+            event.windowId = reinterpret_cast<quintptr>(msg->hwnd);
+            return event;
+        }
+#endif
+
+        if (eventType == QByteArrayLiteral("mac_generic_NSEvent")) {
+            event.type = MacEvent;
+        }
+        return event;
+    }
+
     NativeEventFilter::NativeEventFilter() = default;
 
     NativeEventFilter::~NativeEventFilter() {
@@ -24,10 +101,10 @@ namespace QWK {
         }
     }
 
-    bool NativeEventDispatcher::nativeDispatch(const QByteArray &eventType, void *message,
+    bool NativeEventDispatcher::nativeDispatch(const NativeEvent &event, void *message,
                                                QT_NATIVE_EVENT_RESULT_TYPE *result) {
         for (const auto &ef : std::as_const(m_nativeEventFilters)) {
-            if (ef->nativeEventFilter(eventType, message, result))
+            if (ef->nativeEventFilter(event, message, result))
                 return true;
         }
         return false;
@@ -63,7 +140,10 @@ namespace QWK {
 
         bool nativeEventFilter(const QByteArray &eventType, void *message,
                                QT_NATIVE_EVENT_RESULT_TYPE *result) override {
-            return nativeDispatch(eventType, message, result);
+            if (m_nativeEventFilters.isEmpty()) {
+                return false;
+            }
+            return nativeDispatch(NativeEvent::classify(eventType, message), message, result);
         }
 
         static inline AppMasterNativeEventFilter *instance = nullptr;
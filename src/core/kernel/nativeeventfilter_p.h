@@ -18,6 +18,32 @@
 
 namespace QWK {
 
+    // The event is classified once when it enters the dispatcher, so that the filters can switch
+    // on integers instead of comparing the type string and decoding the message again.
+    struct QWK_CORE_EXPORT NativeEvent {
+        enum Type {
+            Unknown,
+            WindowsMessage, // windows_generic_MSG, windows_dispatcher_MSG: MSG
+            XcbEvent,       // xcb_generic_event_t
+            MacEvent,       // mac_generic_NSEvent: NSEvent
+        };
+
+        Type type = Unknown;
+
+        // MSG::message, or the xcb response type without the synthetic bit
+        quint32 messageType = 0;
+
+        // HWND or xcb_window_t, 0 if the message doesn't refer to a window. It is also 0 for the
+        // xcb GenericEvent (35), which carries the XInput 2 input events on Qt 6, the filters
+        // have to decode those by themselves.
+        quintptr windowId = 0;
+
+        // The raw type, for the events that are not classified
+        const QByteArray *eventType = nullptr;
+
+        static NativeEvent classify(const QByteArray &eventType, void *message);
+    };
+
     class NativeEventFilter;
 
     class QWK_CORE_EXPORT NativeEventDispatcher {
@@ -26,7 +52,7 @@ namespace QWK {
         virtual ~NativeEventDispatcher();
 
     public:
-        virtual bool nativeDispatch(const QByteArray &eventType, void *message,
+        virtual bool nativeDispatch(const NativeEvent &event, void *message,
                                     QT_NATIVE_EVENT_RESULT_TYPE *result);
 
     public:
@@ -47,7 +73,7 @@ namespace QWK {
         virtual ~NativeEventFilter();
 
     public:
-        virtual bool nativeEventFilter(const QByteArray &eventType, void *message,
+        virtual bool nativeEventFilter(const NativeEvent &event, void *message,
                                        QT_NATIVE_EVENT_RESULT_TYPE *result) = 0;
 
     protected:
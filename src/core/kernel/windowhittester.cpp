@@ -0,0 +1,112 @@
+// Copyright (C) 2023-2024 Stdware Collections (https://www.github.com/stdware)
+// Copyright (C) 2021-2023 wangwenx190 (Yuhang Zhao)
+// SPDX-License-Identifier: Apache-2.0
+
+#include "windowhittester_p.h"
+
+namespace QWK {
+
+    static inline Qt::Edges edgesAt(const QPoint &pos, const QSize &size,
+                                    const QMargins &borders) {
+        Qt::Edges edges;
+        if (pos.x() < borders.left()) {
+            edges |= Qt::LeftEdge;
+        } else if (pos.x() >= size.width() - borders.right()) {
+            edges |= Qt::RightEdge;
+        }
+        if (pos.y() < borders.top()) {
+            edges |= Qt::TopEdge;
+        } else if (pos.y() >= size.height() - borders.bottom()) {
+            edges |= Qt::BottomEdge;
+        }
+        return edges;
+    }
+
+    // Returns false if no edge is hit, or if none of the hit edges can be resized, the point
+    // then belongs to what is beneath the border. A corner whose one direction is fixed resizes
+    // in the other one only, like the native frame does. Over a system button the border is
+    // kept, so that the button isn't pressed by a point on the edge of the window.
+    static inline bool hitBorder(Qt::Edges edges, const WindowHitTestFrame &frame,
+                                 bool overButton, WindowHitTestResult *result) {
+        if (!edges) {
+            return false;
+        }
+        Qt::Edges resizable = edges;
+        if (frame.fixedWidth) {
+            resizable &= ~(Qt::LeftEdge | Qt::RightEdge);
+        }
+        if (frame.fixedHeight) {
+            resizable &= ~(Qt::TopEdge | Qt::BottomEdge);
+        }
+        if (resizable) {
+            result->part = WindowHitTestResult::ResizeBorder;
+            result->edges = resizable;
+        } else if (overButton) {
+            result->part = WindowHitTestResult::FixedBorder;
+            result->edges = edges;
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    static inline bool isInTopCorner(const QPoint &pos, const WindowHitTestFrame &frame) {
+        return pos.x() < frame.topCornerLeft ||
+               pos.x() >= frame.size.width() - frame.topCornerRight;
+    }
+
+    WindowHitTester::WindowHitTester() = default;
+
+    WindowHitTester::~WindowHitTester() = default;
+
+    WindowHitTestResult WindowHitTester::hitTest(const QPoint &pos, const QPoint &scenePos,
+                                                 const WindowHitTestFrame &frame) const {
+        WindowHitTestResult result;
+
+        // A window that is not in the normal state, or whose size is fixed in both directions,
+        // has no resize borders at all, the whole border falls through to what is beneath.
+        const bool noState =
+            !(frame.windowState &
+              (Qt::WindowMinimized | Qt::WindowMaximized | Qt::WindowFullScreen));
+        const bool fixedSize = frame.fixedWidth && frame.fixedHeight;
+
+        // The system buttons come first so that only a thin strip of them is given to the
+        // borders, the buttons in the corner stay easy to hit.
+        WindowAgentBase::SystemButton button = WindowAgentBase::Unknown;
+        if (isInSystemButtons(scenePos, &button)) {
+            result.button = button;
+            if (noState) {
+                const Qt::Edges edges = edgesAt(pos, frame.size, frame.buttonResizeBorders);
+                if (edges && fixedSize) {
+                    // The window can't be resized, the strip belongs to the client area so that
+                    // the controls beneath can still be hovered or clicked.
+                    if (isInTitleBarDraggableArea(scenePos)) {
+                        result.part = WindowHitTestResult::TitleBar;
+                    }
+                    return result;
+                }
+                if (hitBorder(edges, frame, true, &result)) {
+                    return result;
+                }
+            }
+            result.part = WindowHitTestResult::SystemButton;
+            return result;
+        }
+
+        if (noState && !fixedSize) {
+            const Qt::Edges edges = edgesAt(pos, frame.size, frame.resizeBorders);
+            const bool fixedCorner =
+                frame.fixedWidth && (edges & Qt::TopEdge) && isInTopCorner(pos, frame);
+            if (!fixedCorner && hitBorder(edges, frame, false, &result)) {
+                return result;
+            }
+        }
+
+        // The title bar stays draggable in full screen, the backends may decide otherwise.
+        if (isInTitleBarDraggableArea(scenePos)) {
+            result.part = WindowHitTestResult::TitleBar;
+        }
+        return result;
+    }
+
+}
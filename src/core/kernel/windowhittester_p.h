@@ -0,0 +1,77 @@
+// Copyright (C) 2023-2024 Stdware Collections (https://www.github.com/stdware)
+// Copyright (C) 2021-2023 wangwenx190 (Yuhang Zhao)
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef WINDOWHITTESTER_P_H
+#define WINDOWHITTESTER_P_H
+
+//
+//  W A R N I N G !!!
+//  -----------------
+//
+// This file is not part of the QWindowKit API. It is used purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or may even be removed.
+//
+
+#include <QtCore/QMargins>
+#include <QtCore/QPoint>
+#include <QtCore/QSize>
+
+#include <QWKCore/windowagentbase.h>
+
+namespace QWK {
+
+    // Describes the window at the time of the hit test. The position passed to hitTest() and the
+    // fields below share one unit, which may be native pixels.
+    struct WindowHitTestFrame {
+        QSize size;
+        // The thickness of the resize border on each side, 0 for a side without one
+        QMargins resizeBorders;
+        QMargins buttonResizeBorders; // Over the system buttons
+        // The width of the corners of the top border on each side, for a frame whose side
+        // borders are outside of the window, e.g. the system borders on Windows. The corners
+        // don't resize a window whose width is fixed at all.
+        int topCornerLeft = 0;
+        int topCornerRight = 0;
+        Qt::WindowStates windowState;
+        bool fixedWidth = false;
+        bool fixedHeight = false;
+    };
+
+    struct WindowHitTestResult {
+        enum Part {
+            ClientArea,
+            TitleBar,
+            SystemButton,
+            ResizeBorder, // edges can be resized
+            FixedBorder,  // edges over a system button are hit but can't be resized
+        };
+
+        Part part = ClientArea;
+        Qt::Edges edges;
+        WindowAgentBase::SystemButton button = WindowAgentBase::Unknown;
+    };
+
+    // Maps a point to the part of the window under it, the backends translate the result to the
+    // platform's own values. The title bar and the system buttons are queried in scene
+    // coordinates, and only when the point is not decided by the borders alone.
+    class QWK_CORE_EXPORT WindowHitTester {
+    public:
+        WindowHitTester();
+        virtual ~WindowHitTester();
+
+    public:
+        virtual bool isInSystemButtons(const QPoint &pos,
+                                       WindowAgentBase::SystemButton *button) const = 0;
+        virtual bool isInTitleBarDraggableArea(const QPoint &pos) const = 0;
+
+        WindowHitTestResult hitTest(const QPoint &pos, const QPoint &scenePos,
+                                    const WindowHitTestFrame &frame) const;
+
+        Q_DISABLE_COPY(WindowHitTester)
+    };
+
+}
+
+#endif // WINDOWHITTESTER_P_H
@@ -8,6 +8,7 @@
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
 #include <QGuiApplication>
 #include <QLibrary>
+#include <QVariant>
 
 namespace QWK {
     namespace Private {
@@ -48,6 +49,37 @@ namespace QWK {
                     api.wl_proxy_get_version =
                         reinterpret_cast<LinuxWaylandAPI::wl_proxy_get_version_fn>(
                             waylib.resolve("wl_proxy_get_version"));
+
+                    api.wl_proxy_add_listener =
+                        reinterpret_cast<LinuxWaylandAPI::wl_proxy_add_listener_fn>(
+                            waylib.resolve("wl_proxy_add_listener"));
+                    api.wl_proxy_set_queue =
+                        reinterpret_cast<LinuxWaylandAPI::wl_proxy_set_queue_fn>(
+                            waylib.resolve("wl_proxy_set_queue"));
+                    api.wl_proxy_create_wrapper =
+                        reinterpret_cast<LinuxWaylandAPI::wl_proxy_create_wrapper_fn>(
+                            waylib.resolve("wl_proxy_create_wrapper"));
+                    api.wl_proxy_wrapper_destroy =
+                        reinterpret_cast<LinuxWaylandAPI::wl_proxy_wrapper_destroy_fn>(
+                            waylib.resolve("wl_proxy_wrapper_destroy"));
+                    api.wl_proxy_destroy = reinterpret_cast<LinuxWaylandAPI::wl_proxy_destroy_fn>(
+                        waylib.resolve("wl_proxy_destroy"));
+                    api.wl_display_create_queue =
+                        reinterpret_cast<LinuxWaylandAPI::wl_display_create_queue_fn>(
+                            waylib.resolve("wl_display_create_queue"));
+                    api.wl_display_roundtrip_queue =
+                        reinterpret_cast<LinuxWaylandAPI::wl_display_roundtrip_queue_fn>(
+                            waylib.resolve("wl_display_roundtrip_queue"));
+                    api.wl_event_queue_destroy =
+                        reinterpret_cast<LinuxWaylandAPI::wl_event_queue_destroy_fn>(
+                            waylib.resolve("wl_event_queue_destroy"));
+                    // A data symbol, not a function
+                    api.wl_registry_interface = reinterpret_cast<const struct wl_interface *>(
+                        waylib.resolve("wl_registry_interface"));
+                    api.wl_region_interface = reinterpret_cast<const struct wl_interface *>(
+                        waylib.resolve("wl_region_interface"));
+                    api.wl_pointer_interface = reinterpret_cast<const struct wl_interface *>(
+                        waylib.resolve("wl_pointer_interface"));
                 }
             }
             guard = false;
@@ -76,12 +108,38 @@ namespace QWK {
                     api.XFlush = reinterpret_cast<LinuxX11API::XFlushFn>(x11lib.resolve("XFlush"));
                     api.XUngrabPointer = reinterpret_cast<LinuxX11API::XUngrabPointerFn>(
                         x11lib.resolve("XUngrabPointer"));
+                    api.XChangeProperty = reinterpret_cast<LinuxX11API::XChangePropertyFn>(
+                        x11lib.resolve("XChangeProperty"));
+                    api.XDeleteProperty = reinterpret_cast<LinuxX11API::XDeletePropertyFn>(
+                        x11lib.resolve("XDeleteProperty"));
+                    api.XGetWindowProperty = reinterpret_cast<LinuxX11API::XGetWindowPropertyFn>(
+                        x11lib.resolve("XGetWindowProperty"));
+                    api.XFree = reinterpret_cast<LinuxX11API::XFreeFn>(x11lib.resolve("XFree"));
                 }
             }
             guard = false;
             return api;
         }
 
+        bool blurEffectEnabled(const QVariant &attribute, bool *enabled) {
+            if (attribute.typeId() == QMetaType::Type::Bool) {
+                *enabled = attribute.toBool();
+                return true;
+            }
+            if (attribute.typeId() == QMetaType::Type::QString) {
+                auto value = attribute.toString();
+                if (value == QStringLiteral("dark") || value == QStringLiteral("light")) {
+                    *enabled = true;
+                    return true;
+                }
+                if (value == QStringLiteral("none")) {
+                    *enabled = false;
+                    return true;
+                }
+            }
+            return false;
+        }
+
     }
 }
 #endif // QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
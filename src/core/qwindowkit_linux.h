@@ -18,8 +18,11 @@
 #include <QtCore/qglobal.h>
 
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+#include <QtCore/QVariant>
 #include <qguiapplication_platform.h>
 
+#include <QWKCore/qwkglobal.h>
+
 // some declarations about x11
 using Atom = unsigned long;
 using Bool = int;
@@ -31,6 +34,23 @@ using XEvent = union _XEvent;
 
 // for wayland
 struct wl_proxy;
+struct wl_event_queue;
+
+// copy from wayland-util.h
+struct wl_message {
+    const char *name;
+    const char *signature;
+    const struct wl_interface **types;
+};
+
+struct wl_interface {
+    const char *name;
+    int version;
+    int method_count;
+    const struct wl_message *methods;
+    int event_count;
+    const struct wl_message *events;
+};
 
 namespace QWK {
     namespace Private {
@@ -42,15 +62,38 @@ namespace QWK {
             using XSendEventFn = int (*)(Display *, Window, Bool, long, XEvent *);
             using XFlushFn = int (*)(Display *);
             using XUngrabPointerFn = int (*)(Display *, unsigned long);
+            using XChangePropertyFn = int (*)(Display *, Window, Atom, Atom, int, int,
+                                              const unsigned char *, int);
+            using XDeletePropertyFn = int (*)(Display *, Window, Atom);
+            using XGetWindowPropertyFn = int (*)(Display *, Window, Atom, long, long, Bool, Atom,
+                                                 Atom *, int *, unsigned long *, unsigned long *,
+                                                 unsigned char **);
+            using XFreeFn = int (*)(void *);
 
             XInternAtomFn XInternAtom = nullptr;
             XSendEventFn XSendEvent = nullptr;
             XFlushFn XFlush = nullptr;
             XUngrabPointerFn XUngrabPointer = nullptr;
 
+            // Used to set window properties
+            XChangePropertyFn XChangeProperty = nullptr;
+            XDeletePropertyFn XDeleteProperty = nullptr;
+
+            // Used to read window properties
+            XGetWindowPropertyFn XGetWindowProperty = nullptr;
+            XFreeFn XFree = nullptr;
+
             inline bool isValid() const {
                 return XInternAtom && XSendEvent && XFlush && XUngrabPointer;
             }
+
+            inline bool canChangeProperties() const {
+                return isValid() && XChangeProperty && XDeleteProperty;
+            }
+
+            inline bool canReadProperties() const {
+                return isValid() && XGetWindowProperty && XFree;
+            }
         };
 
         struct LinuxWaylandAPI {
@@ -58,28 +101,61 @@ namespace QWK {
             Q_DISABLE_COPY(LinuxWaylandAPI)
 
             using wl_display_flush_fn = int (*)(struct wl_display *);
-            using wl_proxy_marshal_flags_fn = void (*)(struct wl_proxy *, uint32_t,
-                                                       const struct wl_interface *, uint32_t,
-                                                       uint32_t, ...);
+            using wl_proxy_marshal_flags_fn = struct wl_proxy *(*) (struct wl_proxy *, uint32_t,
+                                                                    const struct wl_interface *,
+                                                                    uint32_t, uint32_t, ...);
             using wl_proxy_get_version_fn = int (*)(struct wl_proxy *);
+            using wl_proxy_add_listener_fn = int (*)(struct wl_proxy *, void (**)(void), void *);
+            using wl_proxy_set_queue_fn = void (*)(struct wl_proxy *, struct wl_event_queue *);
+            using wl_proxy_create_wrapper_fn = void *(*) (void *);
+            using wl_proxy_wrapper_destroy_fn = void (*)(void *);
+            using wl_proxy_destroy_fn = void (*)(struct wl_proxy *);
+            using wl_display_create_queue_fn = struct wl_event_queue *(*) (struct wl_display *);
+            using wl_display_roundtrip_queue_fn = int (*)(struct wl_display *,
+                                                          struct wl_event_queue *);
+            using wl_event_queue_destroy_fn = void (*)(struct wl_event_queue *);
 
             wl_display_flush_fn wl_display_flush = nullptr;
             wl_proxy_marshal_flags_fn wl_proxy_marshal_flags = nullptr;
             wl_proxy_get_version_fn wl_proxy_get_version = nullptr;
 
+            // Used to bind globals that Qt doesn't expose on a private queue
+            wl_proxy_add_listener_fn wl_proxy_add_listener = nullptr;
+            wl_proxy_set_queue_fn wl_proxy_set_queue = nullptr;
+            wl_proxy_create_wrapper_fn wl_proxy_create_wrapper = nullptr;
+            wl_proxy_wrapper_destroy_fn wl_proxy_wrapper_destroy = nullptr;
+            wl_proxy_destroy_fn wl_proxy_destroy = nullptr;
+            wl_display_create_queue_fn wl_display_create_queue = nullptr;
+            wl_display_roundtrip_queue_fn wl_display_roundtrip_queue = nullptr;
+            wl_event_queue_destroy_fn wl_event_queue_destroy = nullptr;
+            const struct wl_interface *wl_registry_interface = nullptr;
+            const struct wl_interface *wl_region_interface = nullptr;
+            const struct wl_interface *wl_pointer_interface = nullptr;
+
             inline bool isValid() const {
                 return wl_display_flush && wl_proxy_marshal_flags && wl_proxy_get_version;
             }
+
+            inline bool canBindGlobals() const {
+                return isValid() && wl_proxy_add_listener && wl_proxy_set_queue &&
+                       wl_proxy_create_wrapper && wl_proxy_wrapper_destroy && wl_proxy_destroy &&
+                       wl_display_create_queue && wl_display_roundtrip_queue &&
+                       wl_event_queue_destroy && wl_registry_interface;
+            }
         };
 
 
-        bool isWaylandPlatform();
+        QWK_CORE_EXPORT bool isWaylandPlatform();
+
+        QWK_CORE_EXPORT bool isX11Platform();
 
-        bool isX11Platform();
+        QWK_CORE_EXPORT const LinuxX11API &x11API();
 
-        const LinuxX11API &x11API();
+        QWK_CORE_EXPORT const LinuxWaylandAPI &waylandAPI();
 
-        const LinuxWaylandAPI &waylandAPI();
+        // Accepts the values of the "blur-effect" attribute, "dark" and "light" only differ on
+        // macOS. Returns false if the value is invalid.
+        bool blurEffectEnabled(const QVariant &attribute, bool *enabled);
     }
 }
 #endif // QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
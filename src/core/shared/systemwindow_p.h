@@ -14,20 +14,219 @@
 // version without notice, or may even be removed.
 //
 
+#include <memory>
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QLineF>
+#include <QtCore/QtMath>
+#include <QtGui/QGuiApplication>
 #include <QtGui/QWindow>
+#include <QtGui/QScreen>
 #include <QtGui/QMouseEvent>
 
 #include <QWKCore/private/qwkglobal_p.h>
 
 namespace QWK {
 
+    // Extrapolates the pointer to the time the moved window is expected to be presented. It also
+    // measures how far the window actually trails the pointer, and estimates how far it would
+    // trail with and without the extrapolation.
+    class PointerPredictor {
+    public:
+        inline bool isEnabled() const {
+            return m_enabled;
+        }
+
+        inline void setEnabled(bool enabled) {
+            m_enabled = enabled;
+        }
+
+        // Mean distance in pixels between where the pointer says the window should be and where
+        // the platform has put it, sampled whenever the platform confirms a new geometry during
+        // the current or the last emulated operation, in the mode that was active then.
+        inline qreal measuredLag() const {
+            return m_measuredSamples ? m_measuredLagSum / m_measuredSamples : 0;
+        }
+
+        // Estimates, assuming that the window is presented where it was placed for the previous
+        // pointer event: the mean distance between the previous and the current pointer
+        // position, and between the previous prediction and the current pointer position.
+        inline qreal estimatedLag() const {
+            return m_samples ? m_lagSum / m_samples : 0;
+        }
+
+        inline qreal estimatedPredictedLag() const {
+            return m_samples ? m_predictedLagSum / m_samples : 0;
+        }
+
+        inline void begin(const QWindow *window, const QPoint &pos) {
+            const QScreen *screen = window->screen();
+            const qreal refreshRate = screen ? screen->refreshRate() : 0;
+            m_frameInterval = refreshRate > 0 ? 1000 / refreshRate : kDefaultFrameInterval;
+            m_lastPos = pos;
+            m_lastPredicted = pos;
+            m_sampledPos = pos;
+            m_lastTimestamp = 0;
+            m_velocity = {};
+            m_lagSum = 0;
+            m_predictedLagSum = 0;
+            m_samples = 0;
+            m_measuredLagSum = 0;
+            m_measuredSamples = 0;
+            m_clock.start();
+        }
+
+        inline void measure(const QPoint &expected, const QPoint &actual) {
+            m_measuredLagSum += QLineF(expected, actual).length();
+            m_measuredSamples++;
+        }
+
+        // Returns the position the window should follow, which is the pointer itself unless the
+        // prediction is enabled.
+        inline QPoint update(const QPoint &pos, ulong timestamp) {
+            m_lagSum += QLineF(m_lastPos, pos).length();
+            m_predictedLagSum += QLineF(m_lastPredicted, pos).length();
+            m_samples++;
+
+            m_lastPos = pos;
+
+            // Synthesized events may come without a timestamp, use the time of arrival then.
+            if (timestamp == 0) {
+                timestamp = ulong(m_clock.elapsed()) + 1;
+            }
+
+            // Several events may share one timestamp when they are coalesced, measure the
+            // velocity from the first one of them so that no interval is taken as zero.
+            if (m_lastTimestamp == 0) {
+                m_sampledPos = pos;
+                m_lastTimestamp = timestamp;
+            } else if (timestamp > m_lastTimestamp) {
+                const qreal dt = timestamp - m_lastTimestamp;
+                if (dt > kMaxSampleInterval) {
+                    // The pointer has rested, the old velocity says nothing about the next move.
+                    m_velocity = {};
+                } else {
+                    const QPointF velocity = QPointF(pos - m_sampledPos) / dt;
+                    m_velocity = m_velocity * (1 - kSmoothingFactor) + velocity * kSmoothingFactor;
+                }
+                m_sampledPos = pos;
+                m_lastTimestamp = timestamp;
+            }
+
+            QPointF offset = m_velocity * m_frameInterval;
+            const qreal distance = QLineF(QPointF(), offset).length();
+            if (distance > kMaxPredictionDistance) {
+                offset *= kMaxPredictionDistance / distance;
+            }
+            m_lastPredicted = pos + offset.toPoint();
+            return m_enabled ? m_lastPredicted : pos;
+        }
+
+    private:
+        static constexpr const qreal kDefaultFrameInterval = 1000.0 / 60;
+        static constexpr const qreal kMaxSampleInterval = 100;
+        static constexpr const qreal kSmoothingFactor = 0.5;
+        static constexpr const qreal kMaxPredictionDistance = 48;
+
+        bool m_enabled{};
+        qreal m_frameInterval{kDefaultFrameInterval};
+        QPoint m_lastPos;
+        QPoint m_lastPredicted;
+        QPoint m_sampledPos;
+        ulong m_lastTimestamp{};
+        QPointF m_velocity;
+        qreal m_lagSum{};
+        qreal m_predictedLagSum{};
+        int m_samples{};
+        qreal m_measuredLagSum{};
+        int m_measuredSamples{};
+        QElapsedTimer m_clock;
+    };
+
+    // The size limits of a window, enforced by the emulated resize before any geometry is
+    // applied, in the way a window manager enforces them for a native resize.
+    struct WindowSizeConstraints {
+        QSize minimumSize;
+        QSize maximumSize;
+        QSize sizeIncrement;
+        QSize baseSize;
+        qreal aspectRatio{}; // Width divided by height, 0 if the ratio is free
+
+        static inline WindowSizeConstraints fromWindow(const QWindow *window,
+                                                       qreal aspectRatio = 0) {
+            WindowSizeConstraints constraints;
+            constraints.minimumSize = window->minimumSize();
+            constraints.maximumSize = window->maximumSize();
+            constraints.sizeIncrement = window->sizeIncrement();
+            constraints.baseSize = window->baseSize();
+            constraints.aspectRatio = aspectRatio;
+            return constraints;
+        }
+
+        // The dragged edges decide which dimension follows the other one to keep the ratio. The
+        // minimum and maximum sizes win over the ratio, which wins over the size increment: with
+        // a ratio, only the dimension that drives the other one is rounded to its increment.
+        inline QSize constrain(QSize size, Qt::Edges edges) const {
+            size = size.expandedTo(minimumSize).boundedTo(maximumSize);
+
+            // The increments count from the base size, which defaults to the minimum size
+            const QSize base = baseSize.isEmpty() ? minimumSize : baseSize;
+            const auto snap = [](int value, int from, int step) {
+                if (step <= 0 || value <= from) {
+                    return value;
+                }
+                return from + (value - from) / step * step;
+            };
+
+            if (aspectRatio <= 0) {
+                size.setWidth(snap(size.width(), base.width(), sizeIncrement.width()));
+                size.setHeight(snap(size.height(), base.height(), sizeIncrement.height()));
+                return size.expandedTo(minimumSize).boundedTo(maximumSize);
+            }
+
+            // A single edge drives the other dimension, a corner fits the size in the dragged
+            // rectangle.
+            const bool horizontal = edges & (Qt::LeftEdge | Qt::RightEdge);
+            const bool vertical = edges & (Qt::TopEdge | Qt::BottomEdge);
+            int width;
+            if (horizontal && (!vertical || size.width() < size.height() * aspectRatio)) {
+                width = snap(size.width(), base.width(), sizeIncrement.width());
+            } else {
+                width = qRound(snap(size.height(), base.height(), sizeIncrement.height()) *
+                               aspectRatio);
+            }
+
+            // Keep the width where the height that follows it is within the limits too, unless
+            // no size within the limits has the ratio.
+            const int lowest =
+                qCeil(qMax<qreal>(minimumSize.width(), minimumSize.height() * aspectRatio));
+            const int highest =
+                qFloor(qMin<qreal>(maximumSize.width(), maximumSize.height() * aspectRatio));
+            if (lowest <= highest) {
+                width = qBound(lowest, width, highest);
+            }
+            size = QSize(width, qRound(width / aspectRatio));
+            return size.expandedTo(minimumSize).boundedTo(maximumSize);
+        }
+    };
+
     class WindowMoveManipulator : public QObject {
     public:
-        explicit WindowMoveManipulator(QWindow *targetWindow)
+        explicit WindowMoveManipulator(QWindow *targetWindow, bool grabMouse = false,
+                                       std::shared_ptr<PointerPredictor> pointerPredictor = {})
             : QObject(targetWindow), target(targetWindow), operationComplete(false),
-              initialMousePosition(QCursor::pos()),
-              initialWindowPosition(targetWindow->position()) {
+              mouseGrabbed(false), initialMousePosition(QCursor::pos()),
+              initialWindowPosition(targetWindow->position()),
+              pointerPosition(initialMousePosition), predictor(std::move(pointerPredictor)) {
             target->installEventFilter(this);
+            if (predictor) {
+                predictor->begin(target, initialMousePosition);
+            }
+            if (grabMouse) {
+                // The button was pressed on another window which still has the implicit
+                // grab, redirect the rest of the drag to the target.
+                mouseGrabbed = target->setMouseGrabEnabled(true);
+            }
         }
 
     protected:
@@ -38,17 +237,44 @@ namespace QWK {
             switch (event->type()) {
                 case QEvent::MouseMove: {
                     auto mouseEvent = static_cast<QMouseEvent *>(event);
-                    QPoint delta = getMouseEventGlobalPos(mouseEvent) - initialMousePosition;
+                    if (!(mouseEvent->buttons() & Qt::LeftButton)) {
+                        // The release went elsewhere, e.g. to a popup or another application,
+                        // stop following the pointer like the press state machine does.
+                        finish();
+                        break;
+                    }
+                    QPoint globalMousePos = getMouseEventGlobalPos(mouseEvent);
+                    pointerPosition = globalMousePos;
+                    if (predictor) {
+                        globalMousePos = predictor->update(globalMousePos, mouseEvent->timestamp());
+                    }
+                    QPoint delta = globalMousePos - initialMousePosition;
                     target->setPosition(initialWindowPosition + delta);
                     return true;
                 }
 
+                case QEvent::Move: {
+                    // The platform has moved the window, setPosition() only requests it. Compare
+                    // with where the latest pointer event wants the window.
+                    if (predictor) {
+                        predictor->measure(initialWindowPosition + pointerPosition -
+                                               initialMousePosition,
+                                           static_cast<QMoveEvent *>(event)->pos());
+                    }
+                    break;
+                }
+
                 case QEvent::MouseButtonRelease: {
+                    if (predictor && predictor->isEnabled()) {
+                        // Take back what has been predicted but not travelled.
+                        auto mouseEvent = static_cast<QMouseEvent *>(event);
+                        QPoint delta = getMouseEventGlobalPos(mouseEvent) - initialMousePosition;
+                        target->setPosition(initialWindowPosition + delta);
+                    }
                     if (target->y() < 0) {
                         target->setPosition(target->x(), 0);
                     }
-                    operationComplete = true;
-                    deleteLater();
+                    finish();
                     break;
                 }
 
@@ -59,19 +285,37 @@ namespace QWK {
         }
 
     private:
+        void finish() {
+            if (mouseGrabbed) {
+                target->setMouseGrabEnabled(false);
+            }
+            operationComplete = true;
+            deleteLater();
+        }
+
         QWindow *target;
         bool operationComplete;
+        bool mouseGrabbed;
         QPoint initialMousePosition;
         QPoint initialWindowPosition;
+        QPoint pointerPosition;
+        std::shared_ptr<PointerPredictor> predictor;
     };
 
     class WindowResizeManipulator : public QObject {
     public:
-        WindowResizeManipulator(QWindow *targetWindow, Qt::Edges edges)
+        WindowResizeManipulator(QWindow *targetWindow, Qt::Edges edges,
+                                std::shared_ptr<PointerPredictor> pointerPredictor = {},
+                                qreal aspectRatio = 0)
             : QObject(targetWindow), target(targetWindow), operationComplete(false),
               initialMousePosition(QCursor::pos()), initialWindowRect(target->geometry()),
-              resizeEdges(edges) {
+              pointerPosition(initialMousePosition), resizeEdges(edges),
+              predictor(std::move(pointerPredictor)),
+              constraints(WindowSizeConstraints::fromWindow(targetWindow, aspectRatio)) {
             target->installEventFilter(this);
+            if (predictor) {
+                predictor->begin(target, initialMousePosition);
+            }
         }
 
     protected:
@@ -83,30 +327,30 @@ namespace QWK {
                 case QEvent::MouseMove: {
                     auto mouseEvent = static_cast<QMouseEvent *>(event);
                     QPoint globalMousePos = getMouseEventGlobalPos(mouseEvent);
-                    QRect windowRect = initialWindowRect;
-
-                    if (resizeEdges & Qt::LeftEdge) {
-                        int delta = globalMousePos.x() - initialMousePosition.x();
-                        windowRect.setLeft(initialWindowRect.left() + delta);
-                    }
-                    if (resizeEdges & Qt::RightEdge) {
-                        int delta = globalMousePos.x() - initialMousePosition.x();
-                        windowRect.setRight(initialWindowRect.right() + delta);
+                    pointerPosition = globalMousePos;
+                    if (predictor) {
+                        globalMousePos = predictor->update(globalMousePos, mouseEvent->timestamp());
                     }
-                    if (resizeEdges & Qt::TopEdge) {
-                        int delta = globalMousePos.y() - initialMousePosition.y();
-                        windowRect.setTop(initialWindowRect.top() + delta);
-                    }
-                    if (resizeEdges & Qt::BottomEdge) {
-                        int delta = globalMousePos.y() - initialMousePosition.y();
-                        windowRect.setBottom(initialWindowRect.bottom() + delta);
-                    }
-
-                    target->setGeometry(windowRect);
+                    target->setGeometry(resizedRect(globalMousePos));
                     return true;
                 }
 
+                case QEvent::Resize: {
+                    // The geometry is the one the platform has applied by the time the resize
+                    // event is sent. Compare the dragged corner, or the dragged edge of it.
+                    if (predictor) {
+                        predictor->measure(draggedPoint(resizedRect(pointerPosition)),
+                                           draggedPoint(target->geometry()));
+                    }
+                    break;
+                }
+
                 case QEvent::MouseButtonRelease: {
+                    if (predictor && predictor->isEnabled()) {
+                        // Take back what has been predicted but not travelled.
+                        auto mouseEvent = static_cast<QMouseEvent *>(event);
+                        target->setGeometry(resizedRect(getMouseEventGlobalPos(mouseEvent)));
+                    }
                     operationComplete = true;
                     deleteLater();
                     break;
@@ -119,11 +363,66 @@ namespace QWK {
         }
 
     private:
+        QRect resizedRect(const QPoint &globalMousePos) const {
+            QRect windowRect = initialWindowRect;
+
+            if (resizeEdges & Qt::LeftEdge) {
+                int delta = globalMousePos.x() - initialMousePosition.x();
+                windowRect.setLeft(initialWindowRect.left() + delta);
+            }
+            if (resizeEdges & Qt::RightEdge) {
+                int delta = globalMousePos.x() - initialMousePosition.x();
+                windowRect.setRight(initialWindowRect.right() + delta);
+            }
+            if (resizeEdges & Qt::TopEdge) {
+                int delta = globalMousePos.y() - initialMousePosition.y();
+                windowRect.setTop(initialWindowRect.top() + delta);
+            }
+            if (resizeEdges & Qt::BottomEdge) {
+                int delta = globalMousePos.y() - initialMousePosition.y();
+                windowRect.setBottom(initialWindowRect.bottom() + delta);
+            }
+
+            // Constrain the size before applying it, keeping the edges that are not dragged
+            // where they are, so that every step is laid out once.
+            const QSize size = constraints.constrain(windowRect.size(), resizeEdges);
+            if (resizeEdges & Qt::LeftEdge) {
+                windowRect.setLeft(windowRect.right() - size.width() + 1);
+            } else {
+                windowRect.setWidth(size.width());
+            }
+            if (resizeEdges & Qt::TopEdge) {
+                windowRect.setTop(windowRect.bottom() - size.height() + 1);
+            } else {
+                windowRect.setHeight(size.height());
+            }
+            return windowRect;
+        }
+
+        // The corner or the edge that follows the pointer
+        QPoint draggedPoint(const QRect &rect) const {
+            QPoint point;
+            if (resizeEdges & Qt::LeftEdge) {
+                point.setX(rect.left());
+            } else if (resizeEdges & Qt::RightEdge) {
+                point.setX(rect.right());
+            }
+            if (resizeEdges & Qt::TopEdge) {
+                point.setY(rect.top());
+            } else if (resizeEdges & Qt::BottomEdge) {
+                point.setY(rect.bottom());
+            }
+            return point;
+        }
+
         QWindow *target;
         bool operationComplete;
         QPoint initialMousePosition;
         QRect initialWindowRect;
+        QPoint pointerPosition;
         Qt::Edges resizeEdges;
+        std::shared_ptr<PointerPredictor> predictor;
+        WindowSizeConstraints constraints;
     };
 
     // QWindow::startSystemMove() and QWindow::startSystemResize() is first supported at Qt 5.15
@@ -132,30 +431,47 @@ namespace QWK {
 
     // When the new API fails, we emulate the window actions using the classical API.
 
-    inline void startSystemMove(QWindow *window) {
+    // Set grabMouse if the button may have been pressed on another window. The predictor, if
+    // any, is only used when the action is emulated.
+    inline void startSystemMove(QWindow *window, bool grabMouse = false,
+                                const std::shared_ptr<PointerPredictor> &predictor = {}) {
         Q_ASSERT(window);
 #if (QT_VERSION < QT_VERSION_CHECK(5, 15, 0))
-        std::ignore = new WindowMoveManipulator(window);
+        std::ignore = new WindowMoveManipulator(window, grabMouse, predictor);
 #elif defined(Q_OS_LINUX)
         if (window->startSystemMove()) {
             return;
         }
-        std::ignore = new WindowMoveManipulator(window);
+        std::ignore = new WindowMoveManipulator(window, grabMouse, predictor);
 #else
-        window->startSystemMove();
+        if (window->startSystemMove()) {
+            return;
+        }
+        // E.g. macOS can't start the native move without a press event on the window itself.
+        // Don't emulate a move the button is no longer held for, no release would end it.
+        if (!(QGuiApplication::mouseButtons() & Qt::LeftButton)) {
+            return;
+        }
+        std::ignore = new WindowMoveManipulator(window, grabMouse, predictor);
 #endif
     }
 
-    inline void startSystemResize(QWindow *window, Qt::Edges edges) {
+    // The aspect ratio is only enforced when the action is emulated, the system resize relies on
+    // what the platform has been told about the window.
+    inline void startSystemResize(QWindow *window, Qt::Edges edges,
+                                  const std::shared_ptr<PointerPredictor> &predictor = {},
+                                  qreal aspectRatio = 0) {
         Q_ASSERT(window);
 #if (QT_VERSION < QT_VERSION_CHECK(5, 15, 0))
-        std::ignore = new WindowResizeManipulator(window, edges);
+        std::ignore = new WindowResizeManipulator(window, edges, predictor, aspectRatio);
 #elif defined(Q_OS_MAC) || defined(Q_OS_LINUX)
         if (window->startSystemResize(edges)) {
             return;
         }
-        std::ignore = new WindowResizeManipulator(window, edges);
+        std::ignore = new WindowResizeManipulator(window, edges, predictor, aspectRatio);
 #else
+        Q_UNUSED(predictor)
+        Q_UNUSED(aspectRatio)
         window->startSystemResize(edges);
 #endif
     }
@@ -94,12 +94,14 @@ namespace QWK {
         }
 
     protected:
-        bool nativeEventFilter(const QByteArray &eventType, void *message,
+        bool nativeEventFilter(const NativeEvent &event, void *message,
                                QT_NATIVE_EVENT_RESULT_TYPE *result) override {
-            Q_UNUSED(eventType)
+            if (event.type != NativeEvent::WindowsMessage) {
+                return false;
+            }
 
             const auto msg = static_cast<const MSG *>(message);
-            switch (msg->message) {
+            switch (event.messageType) {
                 case WM_DPICHANGED: {
                     updateGeometry();
                     updateExtraMargins(isWindowActive());
@@ -35,15 +35,14 @@ namespace QWK {
 
     class SystemSettingEventFilter : public AppNativeEventFilter {
     public:
-        bool nativeEventFilter(const QByteArray &eventType, void *message,
+        bool nativeEventFilter(const NativeEvent &event, void *message,
                                QT_NATIVE_EVENT_RESULT_TYPE *result) override {
-            Q_UNUSED(eventType)
-            if (!result) {
+            if (event.type != NativeEvent::WindowsMessage || !result) {
                 return false;
             }
 
             const auto msg = static_cast<const MSG *>(message);
-            switch (msg->message) {
+            switch (event.messageType) {
                 case WM_THEMECHANGED:
                 case WM_SYSCOLORCHANGE:
                 case WM_DWMCOLORIZATIONCOLORCHANGED: {
@@ -73,11 +73,98 @@ namespace QWK {
     }
 
     void WindowAgentBasePrivate::setup(QObject *host, WindowItemDelegate *delegate) {
+        Q_Q(WindowAgentBase);
         auto ctx = createContext();
+        QObject::connect(ctx, &AbstractWindowContext::screenChanged, q,
+                         &WindowAgentBase::screenChanged);
+        QObject::connect(ctx, &AbstractWindowContext::activeChanged, q,
+                         [this](bool value) { setActive(value); });
+        QObject::connect(ctx, &AbstractWindowContext::maximizedChanged, q,
+                         [this](bool value) { setMaximized(value); });
+        QObject::connect(ctx, &AbstractWindowContext::movingChanged, q,
+                         [this](bool value) { setMoving(value); });
+        QObject::connect(ctx, &AbstractWindowContext::resizingChanged, q,
+                         [this](bool value) { setResizing(value); });
+        QObject::connect(ctx, &AbstractWindowContext::hoveredSystemButtonChanged, q,
+                         [this](WindowAgentBase::SystemButton value) {
+                             setHoveredSystemButton(value); //
+                         });
+        QObject::connect(ctx, &AbstractWindowContext::pressedSystemButtonChanged, q,
+                         [this](WindowAgentBase::SystemButton value) {
+                             setPressedSystemButton(value); //
+                         });
         ctx->setup(host, delegate);
         context.reset(ctx);
     }
 
+    // The bindable properties of Qt 6 compare and notify by themselves, bindings are only marked
+    // dirty and evaluated when they are read.
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+#  define QWK_WRITE_STATE(MEMBER, VALUE, NOTIFIER) MEMBER = (VALUE)
+#else
+#  define QWK_WRITE_STATE(MEMBER, VALUE, NOTIFIER)                                                 \
+      do {                                                                                         \
+          if (MEMBER != (VALUE)) {                                                                 \
+              MEMBER = (VALUE);                                                                    \
+              Q_EMIT q_ptr->NOTIFIER(MEMBER);                                                      \
+          }                                                                                        \
+      } while (false)
+#endif
+
+    void WindowAgentBasePrivate::setActive(bool value) {
+        QWK_WRITE_STATE(active, value, activeChanged);
+    }
+
+    void WindowAgentBasePrivate::setMaximized(bool value) {
+        QWK_WRITE_STATE(maximized, value, maximizedChanged);
+    }
+
+    void WindowAgentBasePrivate::setMoving(bool value) {
+        QWK_WRITE_STATE(moving, value, movingChanged);
+    }
+
+    void WindowAgentBasePrivate::setResizing(bool value) {
+        QWK_WRITE_STATE(resizing, value, resizingChanged);
+    }
+
+    void WindowAgentBasePrivate::setHoveredSystemButton(WindowAgentBase::SystemButton value) {
+        QWK_WRITE_STATE(hoveredSystemButton, value, hoveredSystemButtonChanged);
+    }
+
+    void WindowAgentBasePrivate::setPressedSystemButton(WindowAgentBase::SystemButton value) {
+        QWK_WRITE_STATE(pressedSystemButton, value, pressedSystemButtonChanged);
+    }
+
+#undef QWK_WRITE_STATE
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    void WindowAgentBasePrivate::emitActiveChanged(bool value) {
+        Q_EMIT q_ptr->activeChanged(value);
+    }
+
+    void WindowAgentBasePrivate::emitMaximizedChanged(bool value) {
+        Q_EMIT q_ptr->maximizedChanged(value);
+    }
+
+    void WindowAgentBasePrivate::emitMovingChanged(bool value) {
+        Q_EMIT q_ptr->movingChanged(value);
+    }
+
+    void WindowAgentBasePrivate::emitResizingChanged(bool value) {
+        Q_EMIT q_ptr->resizingChanged(value);
+    }
+
+    void WindowAgentBasePrivate::emitHoveredSystemButtonChanged(
+        WindowAgentBase::SystemButton value) {
+        Q_EMIT q_ptr->hoveredSystemButtonChanged(value);
+    }
+
+    void WindowAgentBasePrivate::emitPressedSystemButtonChanged(
+        WindowAgentBase::SystemButton value) {
+        Q_EMIT q_ptr->pressedSystemButtonChanged(value);
+    }
+#endif
+
     /*!
         Destructor.
     */
@@ -90,6 +177,9 @@ namespace QWK {
     */
     QVariant WindowAgentBase::windowAttribute(const QString &key) const {
         Q_D(const WindowAgentBase);
+        if (!d->context) {
+            return {};
+        }
         return d->context->windowAttribute(key);
     }
 
@@ -127,17 +217,249 @@ namespace QWK {
                    \c true to enable current theme mode, \c false to disable.
             \li \c title-bar-height: Returns the system title bar height, the system button display
                    area will be limited to this height. (Readonly)
+
+        On Linux,
+            \li \c blur-effect: Specify the same values as on macOS to make the compositor blur
+                   what is behind the window, the blurred area follows the window mask. It is
+                   supported on X11 by compositors that read \c _KDE_NET_WM_BLUR_BEHIND_REGION,
+                   and on Wayland by compositors that implement \c org_kde_kwin_blur. The window
+                   needs a translucent background for the blur to be seen. A new window mask is
+                   picked up with the next update request or expose of the window, call
+                   \c QWindow::requestUpdate() after changing the mask of a widget window.
+
+        Where moving and resizing have to be emulated (on some Linux desktops or before Qt 5.15),
+            \li \c pointer-prediction: Specify a boolean value to make the window follow where the
+                   pointer is expected to be when the next frame is presented, instead of the last
+                   reported position. The final geometry is corrected on release.
+            \li \c pointer-lag: Returns the mean distance in pixels between where the latest
+                   pointer event wants the window and where the platform has moved it, measured
+                   each time the platform confirms a new geometry during the last emulated
+                   operation. Compare the values with and
+                   without \c pointer-prediction to tune it. (Readonly)
+            \li \c estimated-pointer-lag: Returns an estimate of the same distance without
+                   prediction, the mean distance between consecutive pointer events, which assumes
+                   that the window is presented one pointer event late. (Readonly)
+            \li \c estimated-predicted-pointer-lag: Returns the estimate with prediction, the
+                   mean distance between each prediction and the next pointer event. (Readonly)
+            \li \c aspect-ratio: Specify a number (width divided by height) or a size to keep the
+                   ratio of the window while it is resized, an invalid value frees it. The
+                   emulated resize also keeps the minimum and maximum size and the size increment
+                   of the window, and applies the size only once it satisfies all of them. The
+                   minimum and maximum size win over the ratio, which wins over the size
+                   increment. On X11 the ratio is also passed to the window manager in the size
+                   hints, so that the system resize keeps it too. On Windows, Wayland and macOS
+                   the ratio has no effect on the native resize.
+
+        On all platforms,
+            \li \c attachment-lag: Returns the mean distance in pixels between the attached
+                   windows and their place next to the window, taken each time they are moved
+                   into place during the last move. (Readonly)
     */
     bool WindowAgentBase::setWindowAttribute(const QString &key, const QVariant &attribute) {
         Q_D(WindowAgentBase);
+        if (!d->context) {
+            return false;
+        }
         return d->context->setWindowAttribute(key, attribute);
     }
 
+    /*!
+        Returns \c true if the pointer events of the native child \a window are forwarded.
+
+        \sa setChildWindowForwarded()
+    */
+    bool WindowAgentBase::isChildWindowForwarded(const QWindow *window) const {
+        Q_D(const WindowAgentBase);
+        if (!d->context) {
+            return false;
+        }
+        return d->context->isChildWindowForwarded(window);
+    }
+
+    /*!
+        Makes the native child \a window inside the title bar behave like the title bar itself
+        where it covers draggable space, if \a forwarded is \c true. A native child window, such
+        as a window embedded with \c QWindow::fromWinId() or the window handle of a widget with
+        \c Qt::WA_NativeWindow, receives the pointer events of its area directly, so the title
+        bar would otherwise not be draggable over it. Where it overlaps hit-test visible items,
+        the child keeps receiving the events.
+
+        On Windows, the child window is hooked natively and must belong to the current process
+        and thread, otherwise it is not forwarded. On other platforms, only the Qt pointer events
+        of the child window are forwarded, so a window embedded with \c QWindow::fromWinId(),
+        whose events go to the foreign client instead of Qt, is not draggable over.
+    */
+    void WindowAgentBase::setChildWindowForwarded(QWindow *window, bool forwarded) {
+        Q_D(WindowAgentBase);
+        if (!d->context) {
+            return;
+        }
+        d->context->setChildWindowForwarded(window, forwarded);
+    }
+
+    /*!
+        Makes the window of \a agent follow this window, with its position kept at \a offset from
+        the position of this window. Calling it again with another offset changes the offset.
+
+        The moves of this window reported within one pass of the event loop are folded into one
+        move of the attached windows, which happens once the pending events have been processed.
+        On Windows the attached windows are moved together with a single deferred window
+        positioning. On X11 they are not batched, each one is moved on its own. Wayland ignores
+        the position of a toplevel window, so the attached windows don't follow there.
+
+        A window can only be attached to one window at a time, attaching it again detaches it
+        from the previous one. Returns \c true if the window is attached, including when it
+        already was with the same offset, and \c false if it can't be attached, e.g. because it
+        would follow itself.
+
+        The \c attachment-lag window attribute reports how far the attached windows trail.
+
+        \sa detachWindow()
+    */
+    bool WindowAgentBase::attachWindow(WindowAgentBase *agent, const QPoint &offset) {
+        Q_D(WindowAgentBase);
+        if (!d->context || !agent || !agent->d_func()->context) {
+            return false;
+        }
+        return d->context->attachWindow(agent->d_func()->context.get(), offset);
+    }
+
+    /*!
+        Stops the window of \a agent from following this window.
+
+        \sa attachWindow()
+    */
+    bool WindowAgentBase::detachWindow(WindowAgentBase *agent) {
+        Q_D(WindowAgentBase);
+        if (!d->context || !agent || !agent->d_func()->context) {
+            return false;
+        }
+        return d->context->detachWindow(agent->d_func()->context.get());
+    }
+
+    /*!
+        Returns \c true if the window is active.
+
+        The state properties of the agent (\c active, \c maximized, \c moving, \c resizing,
+        \c hoveredSystemButton and \c pressedSystemButton) are updated by the agent's own event
+        handling. With Qt 6 they are bindable, bindings to them are only re-evaluated when they
+        are read after a real change. They belong to the agent itself, before the agent is set up
+        they hold their default values and bindings to them are kept across the setup.
+    */
+    bool WindowAgentBase::isActive() const {
+        Q_D(const WindowAgentBase);
+        return d->active;
+    }
+
+    /*!
+        Returns \c true if the window is maximized.
+    */
+    bool WindowAgentBase::isMaximized() const {
+        Q_D(const WindowAgentBase);
+        return d->maximized;
+    }
+
+    /*!
+        Returns \c true while the window is being moved by the user, with the system move or the
+        emulated one. It is not reported on macOS.
+    */
+    bool WindowAgentBase::isMoving() const {
+        Q_D(const WindowAgentBase);
+        return d->moving;
+    }
+
+    /*!
+        Returns \c true while the window is being resized by the user, with the system resize or
+        the emulated one. It is not reported on macOS.
+    */
+    bool WindowAgentBase::isResizing() const {
+        Q_D(const WindowAgentBase);
+        return d->resizing;
+    }
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    /*!
+        Returns the bindable of the \c active property, it is read-only.
+    */
+    QBindable<bool> WindowAgentBase::bindableActive() {
+        Q_D(WindowAgentBase);
+        return &d->active;
+    }
+
+    /*!
+        Returns the bindable of the \c maximized property, it is read-only.
+    */
+    QBindable<bool> WindowAgentBase::bindableMaximized() {
+        Q_D(WindowAgentBase);
+        return &d->maximized;
+    }
+
+    /*!
+        Returns the bindable of the \c moving property, it is read-only.
+    */
+    QBindable<bool> WindowAgentBase::bindableMoving() {
+        Q_D(WindowAgentBase);
+        return &d->moving;
+    }
+
+    /*!
+        Returns the bindable of the \c resizing property, it is read-only.
+    */
+    QBindable<bool> WindowAgentBase::bindableResizing() {
+        Q_D(WindowAgentBase);
+        return &d->resizing;
+    }
+
+    /*!
+        Returns the bindable of the \c hoveredSystemButton property, it is read-only.
+    */
+    QBindable<WindowAgentBase::SystemButton> WindowAgentBase::bindableHoveredSystemButton() {
+        Q_D(WindowAgentBase);
+        return &d->hoveredSystemButton;
+    }
+
+    /*!
+        Returns the bindable of the \c pressedSystemButton property, it is read-only.
+    */
+    QBindable<WindowAgentBase::SystemButton> WindowAgentBase::bindablePressedSystemButton() {
+        Q_D(WindowAgentBase);
+        return &d->pressedSystemButton;
+    }
+#endif
+
+    /*!
+        Returns the system button under the pointer, or \c Unknown if there is none.
+
+        The agent follows the pointer over the window for all system buttons, so a button can
+        draw its hover feedback from this state instead of tracking hover events itself.
+
+        \sa hoveredSystemButtonChanged()
+    */
+    WindowAgentBase::SystemButton WindowAgentBase::hoveredSystemButton() const {
+        Q_D(const WindowAgentBase);
+        return d->hoveredSystemButton;
+    }
+
+    /*!
+        Returns the system button the left mouse button has been pressed on until it is released,
+        or \c Unknown if there is none. The button stays pressed while the pointer moves away, a
+        click is when it is released over the same button.
+
+        \sa pressedSystemButtonChanged()
+    */
+    WindowAgentBase::SystemButton WindowAgentBase::pressedSystemButton() const {
+        Q_D(const WindowAgentBase);
+        return d->pressedSystemButton;
+    }
+
     /*!
         Shows the system menu, it's only implemented on Windows.
     */
     void WindowAgentBase::showSystemMenu(const QPoint &pos) {
         Q_D(WindowAgentBase);
+        if (!d->context) {
+            return;
+        }
         d->context->showSystemMenu(pos);
     }
 
@@ -146,17 +468,64 @@ namespace QWK {
     */
     void WindowAgentBase::centralize() {
         Q_D(WindowAgentBase);
+        if (!d->context) {
+            return;
+        }
         d->context->virtual_hook(AbstractWindowContext::CentralizeHook, nullptr);
     }
 
     /*!
         Brings the window to top.
+
+        On X11 the window is activated with \c _NET_ACTIVE_WINDOW carrying the last user
+        interaction time, so that the focus stealing prevention of the window manager accepts it.
     */
     void WindowAgentBase::raise() {
         Q_D(WindowAgentBase);
+        if (!d->context) {
+            return;
+        }
         d->context->virtual_hook(AbstractWindowContext::RaiseWindowHook, nullptr);
     }
 
+    /*!
+        Brings the window to top and activates it on behalf of another process, such as the
+        second instance of a single instance application.
+
+        \a activationToken is the token the other process was started with: the
+        \c XDG_ACTIVATION_TOKEN on Wayland, or the \c DESKTOP_STARTUP_ID on X11 whose timestamp
+        is used for the activation request. Other platforms ignore the token and behave like
+        raise().
+    */
+    void WindowAgentBase::activate(const QString &activationToken) {
+        Q_D(WindowAgentBase);
+        if (!d->context) {
+            return;
+        }
+        d->context->virtual_hook(AbstractWindowContext::RaiseWindowHook,
+                                 &const_cast<QString &>(activationToken));
+    }
+
+    /*!
+        Starts moving the window with the mouse button that is currently held down, as if the
+        title bar had been pressed. The button doesn't need to be pressed on this window, so a
+        window that has just been created for a torn off tab can follow the pointer without
+        another press. Pass the window that received the press as \a source, it is released
+        from the drag so that the item that grabbed the mouse there doesn't keep it. The native
+        move is used when available, otherwise it is emulated.
+
+        On Wayland, the compositor only starts a move for the surface that received the press,
+        the request is ignored for any other window and the button has to be pressed again on
+        the new window.
+    */
+    void WindowAgentBase::startSystemMove(QWindow *source) {
+        Q_D(WindowAgentBase);
+        if (!d->context) {
+            return;
+        }
+        d->context->virtual_hook(AbstractWindowContext::StartSystemMoveHook, source);
+    }
+
     /*!
         \internal
     */
@@ -167,4 +536,27 @@ namespace QWK {
         d.init();
     }
 
+    /*!
+        \fn void WindowAgentBase::screenChanged(QScreen *screen, qreal devicePixelRatio)
+
+        This signal is emitted once after the window has moved to another screen or its device
+        pixel ratio has changed, when the new scale has been applied. Use it to invalidate
+        anything rendered or cached for a specific scale.
+    */
+
+    /*!
+        \fn void WindowAgentBase::hoveredSystemButtonChanged(SystemButton button)
+
+        This signal is emitted when the pointer enters another system button or leaves them,
+        \a button is \c Unknown in the latter case. Only the buttons whose state has changed
+        need to be repainted.
+    */
+
+    /*!
+        \fn void WindowAgentBase::pressedSystemButtonChanged(SystemButton button)
+
+        This signal is emitted when a system button is pressed or released, \a button is
+        \c Unknown after the release.
+    */
+
 }
@@ -8,9 +8,17 @@
 #include <memory>
 
 #include <QtCore/QObject>
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+#  include <QtCore/QProperty>
+#endif
 
 #include <QWKCore/qwkglobal.h>
 
+QT_BEGIN_NAMESPACE
+class QScreen;
+class QWindow;
+QT_END_NAMESPACE
+
 namespace QWK {
 
     class WindowAgentBasePrivate;
@@ -31,13 +39,70 @@ namespace QWK {
         };
         Q_ENUM(SystemButton)
 
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+        Q_MOC_INCLUDE(<QtGui/QScreen>)
+        Q_MOC_INCLUDE(<QtGui/QWindow>)
+
+        Q_PROPERTY(bool active READ isActive NOTIFY activeChanged BINDABLE bindableActive)
+        Q_PROPERTY(bool maximized READ isMaximized NOTIFY maximizedChanged BINDABLE
+                       bindableMaximized)
+        Q_PROPERTY(bool moving READ isMoving NOTIFY movingChanged BINDABLE bindableMoving)
+        Q_PROPERTY(bool resizing READ isResizing NOTIFY resizingChanged BINDABLE bindableResizing)
+        Q_PROPERTY(SystemButton hoveredSystemButton READ hoveredSystemButton NOTIFY
+                       hoveredSystemButtonChanged BINDABLE bindableHoveredSystemButton)
+        Q_PROPERTY(SystemButton pressedSystemButton READ pressedSystemButton NOTIFY
+                       pressedSystemButtonChanged BINDABLE bindablePressedSystemButton)
+#else
+        Q_PROPERTY(bool active READ isActive NOTIFY activeChanged)
+        Q_PROPERTY(bool maximized READ isMaximized NOTIFY maximizedChanged)
+        Q_PROPERTY(bool moving READ isMoving NOTIFY movingChanged)
+        Q_PROPERTY(bool resizing READ isResizing NOTIFY resizingChanged)
+        Q_PROPERTY(SystemButton hoveredSystemButton READ hoveredSystemButton NOTIFY
+                       hoveredSystemButtonChanged)
+        Q_PROPERTY(SystemButton pressedSystemButton READ pressedSystemButton NOTIFY
+                       pressedSystemButtonChanged)
+#endif
+
         QVariant windowAttribute(const QString &key) const;
         Q_INVOKABLE bool setWindowAttribute(const QString &key, const QVariant &attribute);
 
+        bool isChildWindowForwarded(const QWindow *window) const;
+        void setChildWindowForwarded(QWindow *window, bool forwarded = true);
+
+        bool attachWindow(WindowAgentBase *agent, const QPoint &offset);
+        bool detachWindow(WindowAgentBase *agent);
+
+        bool isActive() const;
+        bool isMaximized() const;
+        bool isMoving() const;
+        bool isResizing() const;
+        SystemButton hoveredSystemButton() const;
+        SystemButton pressedSystemButton() const;
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+        QBindable<bool> bindableActive();
+        QBindable<bool> bindableMaximized();
+        QBindable<bool> bindableMoving();
+        QBindable<bool> bindableResizing();
+        QBindable<SystemButton> bindableHoveredSystemButton();
+        QBindable<SystemButton> bindablePressedSystemButton();
+#endif
+
     public Q_SLOTS:
         void showSystemMenu(const QPoint &pos); // Not available on macOS.
         void centralize();
         void raise();
+        void activate(const QString &activationToken);
+        void startSystemMove(QWindow *source = nullptr);
+
+    Q_SIGNALS:
+        void screenChanged(QScreen *screen, qreal devicePixelRatio);
+        void activeChanged(bool active);
+        void maximizedChanged(bool maximized);
+        void movingChanged(bool moving);
+        void resizingChanged(bool resizing);
+        void hoveredSystemButtonChanged(SystemButton button);
+        void pressedSystemButtonChanged(SystemButton button);
 
     protected:
         explicit WindowAgentBase(WindowAgentBasePrivate &d, QObject *parent = nullptr);
@@ -14,6 +14,10 @@
 // version without notice, or may even be removed.
 //
 
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+#  include <QtCore/QProperty>
+#endif
+
 #include <QWKCore/windowagentbase.h>
 #include <QWKCore/private/abstractwindowcontext_p.h>
 
@@ -33,6 +37,47 @@ namespace QWK {
 
         void setup(QObject *host, WindowItemDelegate *delegate);
 
+        // The state of the window, written through by the context. It lives as long as the
+        // agent, so that the properties and their bindables are valid before the setup too.
+        void setActive(bool value);
+        void setMaximized(bool value);
+        void setMoving(bool value);
+        void setResizing(bool value);
+        void setHoveredSystemButton(WindowAgentBase::SystemButton value);
+        void setPressedSystemButton(WindowAgentBase::SystemButton value);
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+        void emitActiveChanged(bool value);
+        void emitMaximizedChanged(bool value);
+        void emitMovingChanged(bool value);
+        void emitResizingChanged(bool value);
+        void emitHoveredSystemButtonChanged(WindowAgentBase::SystemButton value);
+        void emitPressedSystemButtonChanged(WindowAgentBase::SystemButton value);
+
+        Q_OBJECT_BINDABLE_PROPERTY(WindowAgentBasePrivate, bool, active,
+                                   &WindowAgentBasePrivate::emitActiveChanged)
+        Q_OBJECT_BINDABLE_PROPERTY(WindowAgentBasePrivate, bool, maximized,
+                                   &WindowAgentBasePrivate::emitMaximizedChanged)
+        Q_OBJECT_BINDABLE_PROPERTY(WindowAgentBasePrivate, bool, moving,
+                                   &WindowAgentBasePrivate::emitMovingChanged)
+        Q_OBJECT_BINDABLE_PROPERTY(WindowAgentBasePrivate, bool, resizing,
+                                   &WindowAgentBasePrivate::emitResizingChanged)
+        Q_OBJECT_BINDABLE_PROPERTY_WITH_ARGS(
+            WindowAgentBasePrivate, WindowAgentBase::SystemButton, hoveredSystemButton,
+            WindowAgentBase::Unknown, &WindowAgentBasePrivate::emitHoveredSystemButtonChanged)
+        Q_OBJECT_BINDABLE_PROPERTY_WITH_ARGS(
+            WindowAgentBasePrivate, WindowAgentBase::SystemButton, pressedSystemButton,
+            WindowAgentBase::Unknown, &WindowAgentBasePrivate::emitPressedSystemButtonChanged)
+#else
+        bool active{};
+        bool maximized{};
+        bool moving{};
+        bool resizing{};
+        WindowAgentBase::SystemButton hoveredSystemButton = WindowAgentBase::Unknown;
+        WindowAgentBase::SystemButton pressedSystemButton = WindowAgentBase::Unknown;
+#endif
+
+        // Declared after the state, the context may still report changes while it is destroyed
         std::unique_ptr<AbstractWindowContext> context;
 
     public:
@@ -44,6 +89,17 @@ namespace QWK {
         Q_DISABLE_COPY(WindowAgentBasePrivate)
     };
 
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    // The bindable properties of the private object are stored with the bindings of the agent
+    inline QBindingStorage *qGetBindingStorage(WindowAgentBasePrivate *d) {
+        return d->q_ptr->bindingStorage();
+    }
+
+    inline const QBindingStorage *qGetBindingStorage(const WindowAgentBasePrivate *d) {
+        return d->q_ptr->bindingStorage();
+    }
+#endif
+
 }
 
 #endif // WINDOWAGENTBASEPRIVATE_H
\ No newline at end of file
@@ -10,6 +10,10 @@ namespace QWK {
 
     WindowItemDelegate::~WindowItemDelegate() = default;
 
+    bool WindowItemDelegate::hitTest(const QObject *obj, const QPoint &scenePos) const {
+        return mapGeometryToScene(obj).contains(scenePos);
+    }
+
     void WindowItemDelegate::resetQtGrabbedControl(QObject *host) const {
         Q_UNUSED(host);
     }
@@ -4,11 +4,123 @@
 
 #include "quickitemdelegate_p.h"
 
+#include <QtCore/QHash>
+#include <QtGui/QTransform>
 #include <QtQuick/QQuickItem>
 #include <QtQuick/QQuickWindow>
 
 namespace QWK {
 
+    // Rotated, scaled or clipped items can't be described by an axis-aligned scene rectangle, so
+    // we keep the inverse of the item-to-scene transform and the accumulated clip rect of each
+    // tracked item. The entry is dropped as soon as any item in its ancestor chain changes, and
+    // rebuilt on the next hit test, so the per-event cost is a single point mapping.
+    //
+    // Note: QQuickItem::transform lists don't notify their owner when a QQuickTransform is
+    // modified, such changes are only picked up with the next geometry notification.
+    class QuickItemHitTestCache : public QObject {
+    public:
+        QuickItemHitTestCache() = default;
+        ~QuickItemHitTestCache() override = default;
+
+        bool hitTest(const QQuickItem *item, const QPointF &scenePos);
+
+    protected:
+        struct Entry {
+            QTransform sceneToItem;
+            QSizeF size;
+            QRectF clipRect; // In scene coordinates, only used if clipped
+            bool clipped = false;
+            bool invertible = false;
+            bool valid = false;
+            QList<QMetaObject::Connection> connections;
+        };
+
+        void update(const QQuickItem *item, Entry &entry);
+        void invalidate(const QQuickItem *item);
+        void remove(const QQuickItem *item);
+
+        QHash<const QQuickItem *, Entry> entries;
+    };
+
+    bool QuickItemHitTestCache::hitTest(const QQuickItem *item, const QPointF &scenePos) {
+        auto it = entries.find(item);
+        if (it == entries.end()) {
+            it = entries.insert(item, {});
+            connect(item, &QObject::destroyed, this, [this, item]() {
+                remove(item); //
+            });
+        }
+
+        auto &entry = it.value();
+        if (!entry.valid) {
+            update(item, entry);
+        }
+        if (!entry.invertible) {
+            // Scaled to zero, nothing can be hit.
+            return false;
+        }
+        if (entry.clipped && !entry.clipRect.contains(scenePos)) {
+            return false;
+        }
+        return QRectF(QPointF(0, 0), entry.size).contains(entry.sceneToItem.map(scenePos));
+    }
+
+    void QuickItemHitTestCache::update(const QQuickItem *item, Entry &entry) {
+        const auto &watch = [this, item, &entry](const QQuickItem *target) {
+            const auto &slot = [this, item]() {
+                invalidate(item); //
+            };
+            entry.connections.append(connect(target, &QQuickItem::xChanged, this, slot));
+            entry.connections.append(connect(target, &QQuickItem::yChanged, this, slot));
+            entry.connections.append(connect(target, &QQuickItem::widthChanged, this, slot));
+            entry.connections.append(connect(target, &QQuickItem::heightChanged, this, slot));
+            entry.connections.append(connect(target, &QQuickItem::rotationChanged, this, slot));
+            entry.connections.append(connect(target, &QQuickItem::scaleChanged, this, slot));
+            entry.connections.append(
+                connect(target, &QQuickItem::transformOriginChanged, this, slot));
+            entry.connections.append(connect(target, &QQuickItem::parentChanged, this, slot));
+            entry.connections.append(connect(target, &QQuickItem::clipChanged, this, slot));
+        };
+
+        entry.sceneToItem = item->itemTransform(nullptr, nullptr).inverted(&entry.invertible);
+        entry.size = item->size();
+        entry.clipped = false;
+        entry.clipRect = {};
+        watch(item);
+
+        // The clip of an item only affects its children, so only the ancestors are considered.
+        for (auto parent = item->parentItem(); parent; parent = parent->parentItem()) {
+            watch(parent);
+            if (!parent->clip()) {
+                continue;
+            }
+            const QRectF rect = parent->mapRectToScene(QRectF(QPointF(0, 0), parent->size()));
+            entry.clipRect = entry.clipped ? entry.clipRect.intersected(rect) : rect;
+            entry.clipped = true;
+        }
+        entry.valid = true;
+    }
+
+    void QuickItemHitTestCache::invalidate(const QQuickItem *item) {
+        auto it = entries.find(item);
+        if (it == entries.end()) {
+            return;
+        }
+        auto &entry = it.value();
+        for (const auto &connection : std::as_const(entry.connections)) {
+            disconnect(connection);
+        }
+        entry.connections.clear();
+        entry.valid = false;
+    }
+
+    void QuickItemHitTestCache::remove(const QQuickItem *item) {
+        // The ancestors outlive the item, drop the connections to them as well
+        invalidate(item);
+        entries.remove(item);
+    }
+
     QuickItemDelegate::QuickItemDelegate() = default;
 
     QuickItemDelegate::~QuickItemDelegate() = default;
@@ -32,6 +144,13 @@ namespace QWK {
         return QRectF(originPoint, size).toRect();
     }
 
+    bool QuickItemDelegate::hitTest(const QObject *obj, const QPoint &scenePos) const {
+        if (!m_hitTestCache) {
+            m_hitTestCache = std::make_unique<QuickItemHitTestCache>();
+        }
+        return m_hitTestCache->hitTest(static_cast<const QQuickItem *>(obj), scenePos);
+    }
+
     QWindow *QuickItemDelegate::hostWindow(const QObject *host) const {
         return static_cast<QQuickWindow *>(const_cast<QObject *>(host));
     }
@@ -14,6 +14,8 @@
 // version without notice, or may even be removed.
 //
 
+#include <memory>
+
 #include <QtCore/QObject>
 #include <QtGui/QWindow>
 
@@ -22,6 +24,8 @@
 
 namespace QWK {
 
+    class QuickItemHitTestCache;
+
     class QWK_QUICK_EXPORT QuickItemDelegate : public WindowItemDelegate {
     public:
         QuickItemDelegate();
@@ -32,6 +36,7 @@ namespace QWK {
         bool isEnabled(const QObject *obj) const override;
         bool isVisible(const QObject *obj) const override;
         QRect mapGeometryToScene(const QObject *obj) const override;
+        bool hitTest(const QObject *obj, const QPoint &scenePos) const override;
 
         QWindow *hostWindow(const QObject *host) const override;
         bool isWindowActive(const QObject *host) const override;
@@ -46,6 +51,11 @@ namespace QWK {
         void setWindowVisible(QObject *host, bool visible) const override;
         void setGeometry(QObject *host, const QRect &rect) override;
         void bringWindowToTop(QObject *host) const override;
+
+    protected:
+        // Lazily created, keeps the inverse scene transform and the clip rect of every item
+        // that has been hit tested.
+        mutable std::unique_ptr<QuickItemHitTestCache> m_hitTestCache;
     };
 
 }
@@ -35,7 +35,7 @@ namespace QWK {
 
     protected:
         bool sharedEventFilter(QObject *obj, QEvent *event) override;
-        bool nativeEventFilter(const QByteArray &eventType, void *message,
+        bool nativeEventFilter(const NativeEvent &event, void *message,
                                QT_NATIVE_EVENT_RESULT_TYPE *result) override;
 
     private:
@@ -156,10 +156,14 @@ namespace QWK {
         return Windows10BorderHandler::sharedEventFilter(obj, event);
     }
 
-    bool BorderItem::nativeEventFilter(const QByteArray &eventType, void *message,
+    bool BorderItem::nativeEventFilter(const NativeEvent &event, void *message,
                                        QT_NATIVE_EVENT_RESULT_TYPE *result) {
+        if (event.type != NativeEvent::WindowsMessage) {
+            return Windows10BorderHandler::nativeEventFilter(event, message, result);
+        }
+
         const auto msg = static_cast<const MSG *>(message);
-        switch (msg->message) {
+        switch (event.messageType) {
             case WM_THEMECHANGED:
             case WM_SYSCOLORCHANGE:
             case WM_DWMCOLORIZATIONCOLORCHANGED: {
@@ -177,7 +181,7 @@ namespace QWK {
             default:
                 break;
         }
-        return Windows10BorderHandler::nativeEventFilter(eventType, message, result);
+        return Windows10BorderHandler::nativeEventFilter(event, message, result);
     }
 
     void BorderItem::_q_afterSynchronizing() {
@@ -28,6 +28,53 @@ namespace QWK {
     void WidgetWindowAgentPrivate::init() {
     }
 
+    void WidgetWindowAgentPrivate::applyTitleBarPalette() {
+        Q_Q(WidgetWindowAgent);
+        if (!hasTitleBarPalettes) {
+            return;
+        }
+
+        const QPalette &palette = darkTheme ? darkTitleBarPalette : lightTitleBarPalette;
+        auto titleBar = q->titleBar();
+
+        // Palette changes propagate to the children and schedule their repaints one by one, hold
+        // them back and repaint the title bar once. Nothing outside of it is touched, unlike a
+        // style sheet on the window which polishes every widget again. Updates the caller has
+        // disabled stay disabled.
+        const bool updatesDisabled =
+            titleBar && titleBar->testAttribute(Qt::WA_ForceUpdatesDisabled);
+        if (titleBar) {
+            if (!updatesDisabled) {
+                titleBar->setUpdatesEnabled(false);
+            }
+            titleBar->setPalette(palette);
+        }
+        for (int i = WindowAgentBase::WindowIcon; i <= WindowAgentBase::Close; ++i) {
+            auto button = q->systemButton(static_cast<WindowAgentBase::SystemButton>(i));
+            if (button && !(titleBar && titleBar->isAncestorOf(button))) {
+                button->setPalette(palette);
+            }
+        }
+        if (titleBar && !updatesDisabled) {
+            titleBar->setUpdatesEnabled(true);
+        }
+    }
+
+    void WidgetWindowAgentPrivate::applyTheme() {
+        Q_Q(WidgetWindowAgent);
+
+        applyTitleBarPalette();
+
+#ifdef Q_OS_WINDOWS
+        // The emulated Windows 10 border needs the dark mode, otherwise it turns white.
+        if (!context->windowAttribute(QStringLiteral("win10-border-needed")).toBool()) {
+            context->setWindowAttribute(QStringLiteral("dark-mode"), darkTheme);
+        }
+#endif
+
+        Q_EMIT q->darkThemeChanged(darkTheme);
+    }
+
     /*!
         Constructs a widget agent, it's better to set the widget to setup as \a parent.
     */
@@ -99,6 +146,7 @@ namespace QWK {
 #ifdef Q_OS_MAC
         setSystemButtonArea(nullptr);
 #endif
+        d->applyTitleBarPalette();
         Q_EMIT titleBarChanged(w);
     }
 
@@ -119,6 +167,7 @@ namespace QWK {
         if (!d->context->setSystemButton(button, w)) {
             return;
         }
+        d->applyTitleBarPalette();
         Q_EMIT systemButtonChanged(button, w);
     }
 
@@ -140,6 +189,83 @@ namespace QWK {
         d->context->setHitTestVisible(w, visible);
     }
 
+    /*!
+        Sets the palettes of the title bar and the system buttons for the light and the dark
+        theme, the one of the current theme is applied right away.
+
+        Colors set by a style sheet take precedence over the palette, so the title bar should not
+        be styled that way for the palettes to take effect. The inactive color group is used when
+        the window is inactive.
+
+        \sa setDarkTheme()
+    */
+    void WidgetWindowAgent::setTitleBarPalettes(const QPalette &light, const QPalette &dark) {
+        Q_D(WidgetWindowAgent);
+        d->lightTitleBarPalette = light;
+        d->darkTitleBarPalette = dark;
+        d->hasTitleBarPalettes = true;
+        d->applyTitleBarPalette();
+    }
+
+    /*!
+        Returns \c true if the dark theme is applied.
+    */
+    bool WidgetWindowAgent::isDarkTheme() const {
+        Q_D(const WidgetWindowAgent);
+        return d->darkTheme;
+    }
+
+    /*!
+        Switches the window between the light and the dark theme in one pass: the title bar
+        palette, the native dark mode where the platform has one, and the \c darkThemeChanged()
+        notification. Only the title bar and the system buttons are repainted.
+    */
+    void WidgetWindowAgent::setDarkTheme(bool dark) {
+        Q_D(WidgetWindowAgent);
+        if (d->darkTheme == dark) {
+            return;
+        }
+        d->darkTheme = dark;
+        d->applyTheme();
+    }
+
+    /*!
+        Returns the style agent the theme follows.
+    */
+    StyleAgent *WidgetWindowAgent::styleAgent() const {
+#if QWINDOWKIT_CONFIG(ENABLE_STYLE_AGENT)
+        Q_D(const WidgetWindowAgent);
+        return d->styleAgent;
+#else
+        return nullptr;
+#endif
+    }
+
+    /*!
+        Makes the theme follow the system theme reported by \a agent, pass \c nullptr to stop
+        following it. It does nothing if the style agent is not built.
+    */
+    void WidgetWindowAgent::setStyleAgent(StyleAgent *agent) {
+#if QWINDOWKIT_CONFIG(ENABLE_STYLE_AGENT)
+        Q_D(WidgetWindowAgent);
+        if (d->styleAgent == agent) {
+            return;
+        }
+        disconnect(d->styleAgentConnection);
+        d->styleAgent = agent;
+        if (!agent) {
+            return;
+        }
+        d->styleAgentConnection =
+            connect(agent, &StyleAgent::systemThemeChanged, this, [this, agent]() {
+                setDarkTheme(agent->systemTheme() == StyleAgent::Dark); //
+            });
+        setDarkTheme(agent->systemTheme() == StyleAgent::Dark);
+#else
+        Q_UNUSED(agent)
+#endif
+    }
+
     /*!
         \internal
     */
@@ -160,4 +286,11 @@ namespace QWK {
         This signal is emitted when a system button is replaced.
     */
 
+    /*!
+        \fn void WidgetWindowAgent::darkThemeChanged(bool dark)
+
+        This signal is emitted after the theme has been switched, the title bar and the native
+        dark mode are already updated by then.
+    */
+
 }
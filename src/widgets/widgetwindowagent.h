@@ -12,6 +12,7 @@
 
 namespace QWK {
 
+    class StyleAgent;
     class WidgetWindowAgentPrivate;
 
     class QWK_WIDGETS_EXPORT WidgetWindowAgent : public WindowAgentBase {
@@ -42,9 +43,18 @@ namespace QWK {
         bool isHitTestVisible(const QWidget *w) const;
         void setHitTestVisible(QWidget *w, bool visible = true);
 
+        void setTitleBarPalettes(const QPalette &light, const QPalette &dark);
+
+        bool isDarkTheme() const;
+        void setDarkTheme(bool dark);
+
+        StyleAgent *styleAgent() const;
+        void setStyleAgent(StyleAgent *agent);
+
     Q_SIGNALS:
         void titleBarChanged(QWidget *w);
         void systemButtonChanged(SystemButton button, QWidget *w);
+        void darkThemeChanged(bool dark);
 
     protected:
         WidgetWindowAgent(WidgetWindowAgentPrivate &d, QObject *parent = nullptr);
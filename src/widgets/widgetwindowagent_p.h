@@ -14,7 +14,13 @@
 // version without notice, or may even be removed.
 //
 
+#include <QtCore/QPointer>
+#include <QtGui/QPalette>
+
 #include <QWKCore/qwkconfig.h>
+#if QWINDOWKIT_CONFIG(ENABLE_STYLE_AGENT)
+#  include <QWKCore/styleagent.h>
+#endif
 #include <QWKCore/private/windowagentbase_p.h>
 #include <QWKWidgets/widgetwindowagent.h>
 
@@ -31,6 +37,19 @@ namespace QWK {
         // Host
         QWidget *hostWidget{};
 
+        // Theme
+        bool darkTheme{};
+        bool hasTitleBarPalettes{};
+        QPalette lightTitleBarPalette;
+        QPalette darkTitleBarPalette;
+#if QWINDOWKIT_CONFIG(ENABLE_STYLE_AGENT)
+        QPointer<StyleAgent> styleAgent;
+        QMetaObject::Connection styleAgentConnection;
+#endif
+
+        void applyTitleBarPalette();
+        void applyTheme();
+
 #ifdef Q_OS_MAC
         QWidget *systemButtonAreaWidget{};
         std::unique_ptr<QObject> systemButtonAreaWidgetEventFilter;
@@ -0,0 +1,200 @@
+// Copyright (C) 2023-2024 Stdware Collections (https://www.github.com/stdware)
+// SPDX-License-Identifier: Apache-2.0
+
+#include <QtCore/QRect>
+#include <QtTest/QTest>
+
+#include <QWKCore/private/windowhittester_p.h>
+
+using namespace QWK;
+
+// A 200x100 window with a 30 pixels high title bar and the close button in its right corner
+class HitTester : public WindowHitTester {
+public:
+    bool isInSystemButtons(const QPoint &pos,
+                           WindowAgentBase::SystemButton *button) const override {
+        if (QRect(170, 0, 30, 30).contains(pos)) {
+            *button = WindowAgentBase::Close;
+            return true;
+        }
+        return false;
+    }
+
+    bool isInTitleBarDraggableArea(const QPoint &pos) const override {
+        return QRect(0, 0, 170, 30).contains(pos);
+    }
+};
+
+class tst_windowhittester : public QObject {
+    Q_OBJECT
+private Q_SLOTS:
+    void hitTest_data();
+    void hitTest();
+};
+
+// The borders of the emulated frame
+static const QMargins kQtBorders(8, 8, 8, 8);
+
+// The borders of the Win32 frame without the system borders, x <= 8 and x > width - 8
+static const QMargins kWin32Borders(9, 9, 7, 7);
+static const QMargins kWin32ButtonBorders(3, 3, 1, 0);
+
+// The borders of the Win32 frame with the system borders, only the top one is in the window
+static const QMargins kWin32SystemBorders(0, 9, 0, 0);
+
+void tst_windowhittester::hitTest_data() {
+    QTest::addColumn<QMargins>("borders");
+    QTest::addColumn<QMargins>("buttonBorders");
+    QTest::addColumn<int>("states");
+    QTest::addColumn<bool>("fixedWidth");
+    QTest::addColumn<bool>("fixedHeight");
+    QTest::addColumn<QPoint>("pos");
+    QTest::addColumn<int>("part");
+    QTest::addColumn<int>("edges");
+    QTest::addColumn<int>("button");
+
+    const int normal = Qt::WindowNoState;
+    const int maximized = Qt::WindowMaximized;
+    const int fullScreen = Qt::WindowFullScreen;
+
+    const int client = WindowHitTestResult::ClientArea;
+    const int titleBar = WindowHitTestResult::TitleBar;
+    const int systemButton = WindowHitTestResult::SystemButton;
+    const int resizeBorder = WindowHitTestResult::ResizeBorder;
+    const int fixedBorder = WindowHitTestResult::FixedBorder;
+
+    const int none = WindowAgentBase::Unknown;
+    const int close = WindowAgentBase::Close;
+
+    QTest::newRow("client") << kQtBorders << kQtBorders << normal << false << false
+                            << QPoint(100, 60) << client << 0 << none;
+    QTest::newRow("title bar") << kQtBorders << kQtBorders << normal << false << false
+                               << QPoint(100, 15) << titleBar << 0 << none;
+    QTest::newRow("left") << kQtBorders << kQtBorders << normal << false << false
+                          << QPoint(7, 60) << resizeBorder << int(Qt::LeftEdge) << none;
+    QTest::newRow("inside left") << kQtBorders << kQtBorders << normal << false << false
+                                 << QPoint(8, 60) << client << 0 << none;
+    QTest::newRow("right") << kQtBorders << kQtBorders << normal << false << false
+                           << QPoint(192, 60) << resizeBorder << int(Qt::RightEdge) << none;
+    QTest::newRow("top left") << kQtBorders << kQtBorders << normal << false << false
+                              << QPoint(2, 2) << resizeBorder
+                              << int(Qt::TopEdge | Qt::LeftEdge) << none;
+    QTest::newRow("bottom right") << kQtBorders << kQtBorders << normal << false << false
+                                  << QPoint(199, 99) << resizeBorder
+                                  << int(Qt::BottomEdge | Qt::RightEdge) << none;
+    QTest::newRow("button") << kQtBorders << kQtBorders << normal << false << false
+                            << QPoint(185, 15) << systemButton << 0 << close;
+    QTest::newRow("button top") << kQtBorders << kQtBorders << normal << false << false
+                                << QPoint(185, 2) << resizeBorder << int(Qt::TopEdge) << close;
+
+    QTest::newRow("maximized left") << kQtBorders << kQtBorders << maximized << false << false
+                                    << QPoint(2, 60) << client << 0 << none;
+    QTest::newRow("maximized title bar") << kQtBorders << kQtBorders << maximized << false
+                                         << false << QPoint(2, 2) << titleBar << 0 << none;
+    QTest::newRow("maximized button top") << kQtBorders << kQtBorders << maximized << false
+                                          << false << QPoint(185, 2) << systemButton << 0
+                                          << close;
+    QTest::newRow("full screen title bar") << kQtBorders << kQtBorders << fullScreen << false
+                                           << false << QPoint(100, 15) << titleBar << 0 << none;
+
+    QTest::newRow("fixed width left") << kQtBorders << kQtBorders << normal << true << false
+                                      << QPoint(2, 60) << client << 0 << none;
+    QTest::newRow("fixed width title bar left")
+        << kQtBorders << kQtBorders << normal << true << false << QPoint(2, 15) << titleBar << 0
+        << none;
+    QTest::newRow("fixed width top left") << kQtBorders << kQtBorders << normal << true << false
+                                          << QPoint(2, 2) << resizeBorder << int(Qt::TopEdge)
+                                          << none;
+    QTest::newRow("fixed height top") << kQtBorders << kQtBorders << normal << false << true
+                                      << QPoint(100, 2) << titleBar << 0 << none;
+    QTest::newRow("fixed height bottom") << kQtBorders << kQtBorders << normal << false << true
+                                         << QPoint(100, 98) << client << 0 << none;
+    QTest::newRow("fixed height button top")
+        << kQtBorders << kQtBorders << normal << false << true << QPoint(185, 2) << fixedBorder
+        << int(Qt::TopEdge) << close;
+    QTest::newRow("fixed size left") << kQtBorders << kQtBorders << normal << true << true
+                                     << QPoint(2, 60) << client << 0 << none;
+    QTest::newRow("fixed size top") << kQtBorders << kQtBorders << normal << true << true
+                                    << QPoint(100, 2) << titleBar << 0 << none;
+    QTest::newRow("fixed size button top") << kQtBorders << kQtBorders << normal << true << true
+                                           << QPoint(185, 2) << client << 0 << close;
+    QTest::newRow("fixed size button") << kQtBorders << kQtBorders << normal << true << true
+                                       << QPoint(185, 15) << systemButton << 0 << close;
+
+    QTest::newRow("win32 left") << kWin32Borders << kWin32ButtonBorders << normal << false
+                                << false << QPoint(8, 60) << resizeBorder << int(Qt::LeftEdge)
+                                << none;
+    QTest::newRow("win32 inside left") << kWin32Borders << kWin32ButtonBorders << normal << false
+                                       << false << QPoint(9, 60) << client << 0 << none;
+    QTest::newRow("win32 right") << kWin32Borders << kWin32ButtonBorders << normal << false
+                                 << false << QPoint(193, 60) << resizeBorder
+                                 << int(Qt::RightEdge) << none;
+    QTest::newRow("win32 inside right") << kWin32Borders << kWin32ButtonBorders << normal
+                                        << false << false << QPoint(192, 60) << client << 0
+                                        << none;
+    QTest::newRow("win32 button top") << kWin32Borders << kWin32ButtonBorders << normal << false
+                                      << false << QPoint(185, 2) << resizeBorder
+                                      << int(Qt::TopEdge) << close;
+    QTest::newRow("win32 button below top") << kWin32Borders << kWin32ButtonBorders << normal
+                                            << false << false << QPoint(185, 3) << systemButton
+                                            << 0 << close;
+    QTest::newRow("win32 button right") << kWin32Borders << kWin32ButtonBorders << normal
+                                        << false << false << QPoint(199, 15) << resizeBorder
+                                        << int(Qt::RightEdge) << close;
+    QTest::newRow("win32 button inside right") << kWin32Borders << kWin32ButtonBorders << normal
+                                               << false << false << QPoint(198, 15)
+                                               << systemButton << 0 << close;
+    QTest::newRow("win32 system borders left")
+        << kWin32SystemBorders << kWin32ButtonBorders << normal << false << false
+        << QPoint(2, 60) << client << 0 << none;
+    QTest::newRow("win32 system borders top left")
+        << kWin32SystemBorders << kWin32ButtonBorders << normal << false << false
+        << QPoint(2, 2) << resizeBorder << int(Qt::TopEdge) << none;
+    QTest::newRow("win32 system borders fixed width top")
+        << kWin32SystemBorders << kWin32ButtonBorders << normal << true << false
+        << QPoint(100, 2) << resizeBorder << int(Qt::TopEdge) << none;
+    QTest::newRow("win32 system borders fixed width top left")
+        << kWin32SystemBorders << kWin32ButtonBorders << normal << true << false
+        << QPoint(8, 2) << titleBar << 0 << none;
+    QTest::newRow("win32 system borders fixed width inside top left")
+        << kWin32SystemBorders << kWin32ButtonBorders << normal << true << false
+        << QPoint(9, 2) << resizeBorder << int(Qt::TopEdge) << none;
+    QTest::newRow("win32 system borders fixed height top")
+        << kWin32SystemBorders << kWin32ButtonBorders << normal << false << true
+        << QPoint(100, 2) << titleBar << 0 << none;
+}
+
+void tst_windowhittester::hitTest() {
+    QFETCH(QMargins, borders);
+    QFETCH(QMargins, buttonBorders);
+    QFETCH(int, states);
+    QFETCH(bool, fixedWidth);
+    QFETCH(bool, fixedHeight);
+    QFETCH(QPoint, pos);
+    QFETCH(int, part);
+    QFETCH(int, edges);
+    QFETCH(int, button);
+
+    WindowHitTestFrame frame;
+    frame.size = QSize(200, 100);
+    frame.resizeBorders = borders;
+    frame.buttonResizeBorders = buttonBorders;
+    if (borders == kWin32SystemBorders) {
+        // The corners of the top border end where the side borders would begin
+        frame.topCornerLeft = kWin32Borders.left();
+        frame.topCornerRight = kWin32Borders.right();
+    }
+    frame.windowState = Qt::WindowStates(states);
+    frame.fixedWidth = fixedWidth;
+    frame.fixedHeight = fixedHeight;
+
+    const HitTester tester;
+    const WindowHitTestResult result = tester.hitTest(pos, pos, frame);
+    QCOMPARE(int(result.part), part);
+    QCOMPARE(int(result.edges), edges);
+    QCOMPARE(int(result.button), button);
+}
+
+QTEST_APPLESS_MAIN(tst_windowhittester)
+
+#include "tst_windowhittester.moc"
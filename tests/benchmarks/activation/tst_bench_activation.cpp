@@ -0,0 +1,114 @@
+// Copyright (C) 2023-2024 Stdware Collections (https://www.github.com/stdware)
+// SPDX-License-Identifier: Apache-2.0
+
+#include <functional>
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QEventLoop>
+#include <QtCore/QTimer>
+#include <QtGui/QGuiApplication>
+#include <QtGui/QWindow>
+#include <QtTest/QTest>
+#include <QtWidgets/QWidget>
+
+#include <QWKWidgets/widgetwindowagent.h>
+
+// Measures the time from an activation request on the agent to the window becoming the focus
+// window. On X11 the request is a _NET_ACTIVE_WINDOW message and on Wayland an xdg-activation
+// request, the window manager may delay or refuse both.
+class tst_bench_activation : public QObject {
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+    void activate_data();
+    void activate();
+
+private:
+    QWidget *m_other = nullptr;
+    QWidget *m_window = nullptr;
+    QWK::WidgetWindowAgent *m_agent = nullptr;
+};
+
+static constexpr const int kRounds = 10;
+static constexpr const int kTimeout = 5000;
+
+// Returns the nanoseconds until the window got the focus, -1 on timeout.
+static qint64 activationLatency(QWindow *window, const std::function<void()> &request) {
+    QEventLoop loop;
+    QElapsedTimer timer;
+    qint64 latency = -1;
+    QObject::connect(qApp, &QGuiApplication::focusWindowChanged, &loop,
+                     [&](QWindow *focusWindow) {
+                         if (focusWindow == window && latency < 0) {
+                             latency = timer.nsecsElapsed();
+                             loop.quit();
+                         }
+                     });
+    QTimer::singleShot(kTimeout, &loop, &QEventLoop::quit);
+
+    timer.start();
+    request();
+    if (latency < 0) {
+        loop.exec();
+    }
+    return latency;
+}
+
+void tst_bench_activation::initTestCase() {
+    m_other = new QWidget();
+    m_other->resize(320, 240);
+    m_other->show();
+
+    m_window = new QWidget();
+    m_window->resize(320, 240);
+    m_agent = new QWK::WidgetWindowAgent(m_window);
+    QVERIFY(m_agent->setup(m_window));
+    m_window->show();
+
+    QVERIFY(QTest::qWaitForWindowExposed(m_other));
+    QVERIFY(QTest::qWaitForWindowExposed(m_window));
+}
+
+void tst_bench_activation::cleanupTestCase() {
+    delete m_window;
+    delete m_other;
+}
+
+void tst_bench_activation::activate_data() {
+    QTest::addColumn<QString>("token");
+
+    QTest::newRow("raise") << QString();
+    // A token handed over by a launcher, it can only be used once
+    QTest::newRow("token") << qEnvironmentVariable("XDG_ACTIVATION_TOKEN");
+}
+
+void tst_bench_activation::activate() {
+    QFETCH(QString, token);
+    if (QTest::currentDataTag() == QByteArray("token") && token.isEmpty()) {
+        QSKIP("XDG_ACTIVATION_TOKEN is not set");
+    }
+
+    const int rounds = token.isEmpty() ? kRounds : 1;
+    qint64 total = 0;
+    for (int i = 0; i < rounds; ++i) {
+        // Give the focus away first, so that every round is a real activation
+        m_other->activateWindow();
+        QTest::qWaitForWindowActive(m_other, kTimeout);
+
+        const qint64 latency = activationLatency(m_window->windowHandle(), [&]() {
+            if (token.isEmpty()) {
+                m_agent->raise();
+            } else {
+                m_agent->activate(token);
+            }
+        });
+        QVERIFY2(latency >= 0, "The window was not activated");
+        total += latency;
+    }
+    QTest::setBenchmarkResult(qreal(total) / rounds / 1e6, QTest::WalltimeMilliseconds);
+}
+
+QTEST_MAIN(tst_bench_activation)
+
+#include "tst_bench_activation.moc"
@@ -0,0 +1,274 @@
+// Copyright (C) 2023-2024 Stdware Collections (https://www.github.com/stdware)
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstdio>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDeadlineTimer>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QEventLoop>
+#include <QtCore/QProcess>
+#include <QtCore/QTimer>
+#include <QtGui/QPainter>
+#include <QtTest/QTest>
+#include <QtWidgets/QApplication>
+#include <QtWidgets/QWidget>
+
+#include <QWKWidgets/widgetwindowagent.h>
+
+#ifdef QWINDOWKIT_TEST_QUICK
+#  include <QtQuick/QQuickWindow>
+
+#  include <QWKQuick/quickwindowagent.h>
+#endif
+
+#if defined(Q_OS_LINUX) && QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+#  include <QWKCore/qwindowkit_linux.h>
+#endif
+
+// Measures the cold start of a frameless window, each round starts a new process of this
+// executable which creates one window and reports its phases:
+//
+//  - library-load: from the spawn of the process to main(), that is the dynamic loading of Qt
+//    and QWindowKit;
+//  - backend-probe: the platform checks and the loading of the native APIs, done once per
+//    process;
+//  - context-creation: the creation and the setup of the agent, without the probe;
+//  - native-window: the creation of the native window, which applies the frameless flags;
+//  - attributes: setting the window attributes an application usually sets at startup;
+//  - first-frame: from show() to the first frame presented by the window.
+//
+// The child inherits the platform plugin, so the benchmark runs on offscreen, on xcb under Xvfb
+// and on wayland with a headless compositor alike.
+class tst_bench_coldstart : public QObject {
+    Q_OBJECT
+private Q_SLOTS:
+    void coldStart_data();
+    void coldStart();
+};
+
+static const char kColdStartArgument[] = "-cold-start";
+
+static constexpr const int kRounds = 5;
+static constexpr const int kTimeout = 10000;
+
+// The backing store is flushed once the paint event has returned, the queued call is the first
+// thing that runs after it.
+class FrameWidget : public QWidget {
+public:
+    explicit FrameWidget(QEventLoop *loop, QElapsedTimer *timer, qint64 *nsecs)
+        : m_loop(loop), m_timer(timer), m_nsecs(nsecs) {
+    }
+
+protected:
+    void paintEvent(QPaintEvent *event) override {
+        Q_UNUSED(event)
+        QPainter painter(this);
+        painter.fillRect(rect(), Qt::white);
+        if (!m_painted) {
+            m_painted = true;
+            QMetaObject::invokeMethod(
+                this,
+                [this]() {
+                    *m_nsecs = m_timer->nsecsElapsed();
+                    m_loop->quit();
+                },
+                Qt::QueuedConnection);
+        }
+    }
+
+private:
+    QEventLoop *m_loop;
+    QElapsedTimer *m_timer;
+    qint64 *m_nsecs;
+    bool m_painted = false;
+};
+
+static void probeBackend() {
+#if defined(Q_OS_LINUX) && QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    // The same checks as the creation of the first context
+    if (QWK::Private::isWaylandPlatform()) {
+        QWK::Private::waylandAPI();
+    }
+    if (QWK::Private::isX11Platform()) {
+        QWK::Private::x11API();
+    }
+#endif
+}
+
+static void setAttributes(QWK::WindowAgentBase *agent) {
+    // The platforms refuse the attributes they don't support, which only costs the lookup
+    agent->setWindowAttribute(QStringLiteral("dark-mode"), true);
+    agent->setWindowAttribute(QStringLiteral("blur-effect"), QStringLiteral("dark"));
+    agent->setWindowAttribute(QStringLiteral("aspect-ratio"), 16.0 / 10.0);
+}
+
+static void printPhase(const char *phase, qint64 nsecs) {
+    std::printf("%s %lld\n", phase, static_cast<long long>(nsecs));
+}
+
+static int runWidgetColdStart() {
+    QEventLoop loop;
+    QElapsedTimer timer;
+    qint64 firstFrame = -1;
+    FrameWidget window(&loop, &timer, &firstFrame);
+    window.resize(640, 400);
+
+    timer.start();
+    auto agent = new QWK::WidgetWindowAgent(&window);
+    if (!agent->setup(&window)) {
+        return 1;
+    }
+    printPhase("context-creation", timer.nsecsElapsed());
+
+    timer.restart();
+    window.winId();
+    printPhase("native-window", timer.nsecsElapsed());
+
+    timer.restart();
+    setAttributes(agent);
+    printPhase("attributes", timer.nsecsElapsed());
+
+    QTimer::singleShot(kTimeout, &loop, &QEventLoop::quit);
+    timer.restart();
+    window.show();
+    loop.exec();
+    printPhase("first-frame", firstFrame);
+    return firstFrame < 0 ? 1 : 0;
+}
+
+#ifdef QWINDOWKIT_TEST_QUICK
+static int runQuickColdStart() {
+    QEventLoop loop;
+    QElapsedTimer timer;
+    qint64 firstFrame = -1;
+    QQuickWindow window;
+    window.resize(640, 400);
+    // The render thread emits it once the frame has been handed to the platform
+    QObject::connect(
+        &window, &QQuickWindow::frameSwapped, &loop,
+        [&]() {
+            if (firstFrame < 0) {
+                firstFrame = timer.nsecsElapsed();
+                QMetaObject::invokeMethod(&loop, &QEventLoop::quit, Qt::QueuedConnection);
+            }
+        },
+        Qt::DirectConnection);
+
+    timer.start();
+    auto agent = new QWK::QuickWindowAgent(&window);
+    if (!agent->setup(&window)) {
+        return 1;
+    }
+    printPhase("context-creation", timer.nsecsElapsed());
+
+    timer.restart();
+    window.create();
+    printPhase("native-window", timer.nsecsElapsed());
+
+    timer.restart();
+    setAttributes(agent);
+    printPhase("attributes", timer.nsecsElapsed());
+
+    QTimer::singleShot(kTimeout, &loop, &QEventLoop::quit);
+    timer.restart();
+    window.show();
+    loop.exec();
+    printPhase("first-frame", firstFrame);
+    return firstFrame < 0 ? 1 : 0;
+}
+#endif
+
+// Runs the cold start of one window in this process, the phases are printed in nanoseconds.
+static int runColdStart(int &argc, char **argv, qint64 mainNsecs) {
+    const QByteArray agent = argv[2];
+    printPhase("library-load", mainNsecs - QByteArray(argv[3]).toLongLong());
+
+#ifdef QWINDOWKIT_TEST_QUICK
+    if (agent == "quick") {
+        // Measure the window and not the graphics stack, which headless setups often lack
+        QQuickWindow::setSceneGraphBackend(QStringLiteral("software"));
+    }
+#endif
+    QApplication app(argc, argv);
+
+    QElapsedTimer timer;
+    timer.start();
+    probeBackend();
+    printPhase("backend-probe", timer.nsecsElapsed());
+
+    int res = 1;
+    if (agent == "widget") {
+        res = runWidgetColdStart();
+    }
+#ifdef QWINDOWKIT_TEST_QUICK
+    if (agent == "quick") {
+        res = runQuickColdStart();
+    }
+#endif
+    std::fflush(stdout);
+    return res;
+}
+
+void tst_bench_coldstart::coldStart_data() {
+    QTest::addColumn<QString>("agent");
+    QTest::addColumn<QByteArray>("phase");
+
+    QStringList agents = {QStringLiteral("widget")};
+#ifdef QWINDOWKIT_TEST_QUICK
+    agents.append(QStringLiteral("quick"));
+#endif
+    static const char *const phases[] = {
+        "library-load", "backend-probe", "context-creation",
+        "native-window", "attributes",   "first-frame",
+    };
+    for (const auto &agent : std::as_const(agents)) {
+        for (const char *phase : phases) {
+            QTest::addRow("%s %s", qPrintable(agent), phase) << agent << QByteArray(phase);
+        }
+    }
+}
+
+void tst_bench_coldstart::coldStart() {
+    QFETCH(QString, agent);
+    QFETCH(QByteArray, phase);
+
+    qint64 total = 0;
+    for (int i = 0; i < kRounds; ++i) {
+        QProcess process;
+        process.setProcessChannelMode(QProcess::ForwardedErrorChannel);
+        process.start(QCoreApplication::applicationFilePath(),
+                      {QString::fromLatin1(kColdStartArgument), agent,
+                       QString::number(QDeadlineTimer::current().deadlineNSecs())});
+        QVERIFY2(process.waitForFinished(kTimeout * 2), "The cold start did not finish");
+        QCOMPARE(process.exitStatus(), QProcess::NormalExit);
+        QCOMPARE(process.exitCode(), 0);
+
+        qint64 nsecs = -1;
+        const auto lines = process.readAllStandardOutput().split('\n');
+        for (const auto &line : lines) {
+            const auto fields = line.trimmed().split(' ');
+            if (fields.size() == 2 && fields.first() == phase) {
+                nsecs = fields.last().toLongLong();
+            }
+        }
+        QVERIFY2(nsecs >= 0, "The phase was not reported");
+        total += nsecs;
+    }
+    QTest::setBenchmarkResult(qreal(total) / kRounds / 1e6, QTest::WalltimeMilliseconds);
+}
+
+int main(int argc, char *argv[]) {
+    // The libraries are loaded by now, the clock is the same monotonic clock in every process
+    const qint64 mainNsecs = QDeadlineTimer::current().deadlineNSecs();
+    if (argc == 4 && qstrcmp(argv[1], kColdStartArgument) == 0) {
+        return runColdStart(argc, argv, mainNsecs);
+    }
+
+    QCoreApplication app(argc, argv);
+    tst_bench_coldstart tc;
+    QTEST_SET_MAIN_SOURCE_PATH
+    return QTest::qExec(&tc, argc, argv);
+}
+
+#include "tst_bench_coldstart.moc"
@@ -0,0 +1,131 @@
+// Copyright (C) 2023-2024 Stdware Collections (https://www.github.com/stdware)
+// SPDX-License-Identifier: Apache-2.0
+
+#include <QtCore/QCoreApplication>
+#include <QtGui/QMouseEvent>
+#include <QtGui/QWindow>
+#include <QtTest/QTest>
+#include <QtWidgets/QHBoxLayout>
+#include <QtWidgets/QPushButton>
+#include <QtWidgets/QVBoxLayout>
+#include <QtWidgets/QWidget>
+
+#include <QWKCore/private/windowagentbase_p.h>
+#include <QWKWidgets/widgetwindowagent.h>
+
+// Measures the pointer hovering over a frameless window: every move goes through the agent,
+// which hit tests the title bar, the system buttons and the borders and updates the hovered
+// system button and the cursor.
+//
+// The uncached rows are the baseline: the window cache is refreshed before every move, which
+// queries the window flags, states and size limits for each event as the hit test did before
+// the cache. The difference with the cached row of the same area is what the cache saves.
+class BenchWindowAgent : public QWK::WidgetWindowAgent {
+public:
+    using WidgetWindowAgent::WidgetWindowAgent;
+
+    QWK::AbstractWindowContext *context() const {
+        return d_ptr->context.get();
+    }
+};
+
+class tst_bench_hover : public QObject {
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+    void hover_data();
+    void hover();
+
+private:
+    QWidget *m_window = nullptr;
+    BenchWindowAgent *m_agent = nullptr;
+};
+
+void tst_bench_hover::initTestCase() {
+    m_window = new QWidget();
+    m_window->resize(1280, 800);
+
+    // A 32 pixels high title bar with three system buttons on the right
+    auto titleBar = new QWidget();
+    titleBar->setFixedHeight(32);
+    auto titleLayout = new QHBoxLayout(titleBar);
+    titleLayout->setContentsMargins(0, 0, 0, 0);
+    titleLayout->setSpacing(0);
+    titleLayout->addStretch();
+    QWidget *buttons[3];
+    for (auto &button : buttons) {
+        button = new QPushButton();
+        button->setFixedSize(50, 32);
+        titleLayout->addWidget(button);
+    }
+
+    auto layout = new QVBoxLayout(m_window);
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->setSpacing(0);
+    layout->addWidget(titleBar);
+    layout->addStretch();
+
+    m_agent = new BenchWindowAgent(m_window);
+    QVERIFY(m_agent->setup(m_window));
+    m_agent->setTitleBar(titleBar);
+    m_agent->setSystemButton(QWK::WindowAgentBase::Minimize, buttons[0]);
+    m_agent->setSystemButton(QWK::WindowAgentBase::Maximize, buttons[1]);
+    m_agent->setSystemButton(QWK::WindowAgentBase::Close, buttons[2]);
+
+    m_window->show();
+    QVERIFY(QTest::qWaitForWindowExposed(m_window));
+}
+
+void tst_bench_hover::cleanupTestCase() {
+    delete m_window;
+}
+
+void tst_bench_hover::hover_data() {
+    QTest::addColumn<QRect>("area");
+    QTest::addColumn<bool>("cached");
+
+    const QPair<const char *, QRect> areas[] = {
+        {"title bar",      QRect(0, 0, 1130, 32)  },
+        {"system buttons", QRect(1130, 0, 150, 32)},
+        {"borders",        QRect(0, 0, 8, 800)    },
+        {"client area",    QRect(8, 32, 1264, 760)},
+    };
+    for (const auto &area : areas) {
+        QTest::addRow("%s", area.first) << area.second << true;
+        QTest::addRow("%s uncached", area.first) << area.second << false;
+    }
+}
+
+void tst_bench_hover::hover() {
+    QFETCH(QRect, area);
+    QFETCH(bool, cached);
+
+    QWindow *window = m_window->windowHandle();
+    QVERIFY(window);
+    QWK::AbstractWindowContext *context = m_agent->context();
+    QVERIFY(context);
+
+    // Every 4th pixel of the area, which is about the moves of a pointer sweeping over it
+    QVector<QPoint> positions;
+    for (int y = area.top(); y <= area.bottom(); y += 4) {
+        for (int x = area.left(); x <= area.right(); x += 4) {
+            positions.append(QPoint(x, y));
+        }
+    }
+
+    QBENCHMARK {
+        for (const auto &pos : std::as_const(positions)) {
+            if (!cached) {
+                context->updateWindowCache();
+            }
+            QMouseEvent event(QEvent::MouseMove, pos, pos, window->mapToGlobal(pos),
+                              Qt::NoButton, Qt::NoButton, Qt::NoModifier);
+            QCoreApplication::sendEvent(window, &event);
+        }
+    }
+}
+
+QTEST_MAIN(tst_bench_hover)
+
+#include "tst_bench_hover.moc"
@@ -0,0 +1,82 @@
+// Copyright (C) 2023-2024 Stdware Collections (https://www.github.com/stdware)
+// SPDX-License-Identifier: Apache-2.0
+
+#include <QtCore/QRect>
+#include <QtTest/QTest>
+
+#include <QWKCore/private/windowhittester_p.h>
+
+using namespace QWK;
+
+// A 1280x800 window with a 32 pixels high title bar and three system buttons on the right, the
+// title bar and the buttons are plain rectangles so that the engine itself is measured.
+class HitTester : public WindowHitTester {
+public:
+    bool isInSystemButtons(const QPoint &pos,
+                           WindowAgentBase::SystemButton *button) const override {
+        static const QRect minimize(1130, 0, 50, 32);
+        static const QRect maximize(1180, 0, 50, 32);
+        static const QRect close(1230, 0, 50, 32);
+        if (minimize.contains(pos)) {
+            *button = WindowAgentBase::Minimize;
+            return true;
+        }
+        if (maximize.contains(pos)) {
+            *button = WindowAgentBase::Maximize;
+            return true;
+        }
+        if (close.contains(pos)) {
+            *button = WindowAgentBase::Close;
+            return true;
+        }
+        return false;
+    }
+
+    bool isInTitleBarDraggableArea(const QPoint &pos) const override {
+        static const QRect titleBar(0, 0, 1130, 32);
+        return titleBar.contains(pos);
+    }
+};
+
+// Classifies every 4th pixel of the window, which is about the number of hit tests of a pointer
+// sweeping over it.
+class tst_bench_windowhittester : public QObject {
+    Q_OBJECT
+private Q_SLOTS:
+    void hitTest_data();
+    void hitTest();
+};
+
+void tst_bench_windowhittester::hitTest_data() {
+    QTest::addColumn<int>("states");
+
+    QTest::newRow("normal") << int(Qt::WindowNoState);
+    QTest::newRow("maximized") << int(Qt::WindowMaximized);
+}
+
+void tst_bench_windowhittester::hitTest() {
+    QFETCH(int, states);
+
+    WindowHitTestFrame frame;
+    frame.size = QSize(1280, 800);
+    frame.resizeBorders = QMargins(8, 8, 8, 8);
+    frame.buttonResizeBorders = QMargins(2, 2, 2, 0);
+    frame.windowState = Qt::WindowStates(states);
+
+    const HitTester tester;
+    int hits = 0;
+    QBENCHMARK {
+        hits = 0;
+        for (int y = 0; y < frame.size.height(); y += 4) {
+            for (int x = 0; x < frame.size.width(); x += 4) {
+                const QPoint pos(x, y);
+                hits += tester.hitTest(pos, pos, frame).part != WindowHitTestResult::ClientArea;
+            }
+        }
+    }
+    QVERIFY(hits > 0);
+}
+
+QTEST_APPLESS_MAIN(tst_bench_windowhittester)
+
+#include "tst_bench_windowhittester.moc"